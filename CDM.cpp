@@ -22,26 +22,72 @@
 #include <stack>		 // For stack data structure
 #include <algorithm>	 // For algorithms like sort, find, etc.
 #include <map>			 // For map data structure
+#include <set>			 // For ordered set data structure
+#include <deque>		 // For per-department work queues
+#include <unordered_set> // For cancelled deal IDs
+#include <new>			 // For placement new (slab allocator)
+#include <type_traits>	 // For compile-time type checks
+#include <chrono>		 // For benchmark timing
+#include <atomic>		 // For lock-free queue sequence counters
+#include <thread>		 // For concurrent intake and benchmark threads
+#include <mutex>		 // For the locked queue baseline in benchmarks
+#include <cstddef>		 // For offsetof
+#include <random>		 // For simulated arrivals and service times
+#include <cmath>		 // For fabs
 
 using namespace std; // Use standard namespace to avoid writing std:: repeatedly
 
 // Data Structures for Car Dealership Management System
 // This section defines various data structures used throughout the program
 
-// 1. Car Node for Linked List (Car Inventory Management)
+// Name Dictionary for String Interning (brand, model and color names mapped to small integer IDs)
+// Every name is stored once; records keep the integer ID so comparisons and grouping are integer ops.
+struct NameTable
+{
+	vector<string> names;				 // ID -> name
+	unordered_map<string, int> nameToID; // name -> ID
+
+	// Return the ID of a name, adding it to the table on first use
+	int intern(const string &name)
+	{
+		auto it = nameToID.find(name);
+		if (it != nameToID.end())
+		{
+			return it->second;
+		}
+		int id = (int)names.size();
+		names.push_back(name);
+		nameToID[name] = id;
+		return id;
+	}
+
+	const string &nameOf(int id) const { return names[id]; }
+};
+
+// Global dictionary shared by the inventory, order menus and order logs
+NameTable nameDictionary;
+
+// 1. Car Record (snapshot of one row of the columnar inventory store)
 struct CarNode
 {
 	int carID;		  // Unique identifier for each car
-	string brand;	  // Car manufacturer (e.g., Toyota, Honda)
-	string model;	  // Car model name (e.g., Camry, Civic)
+	int brandID;	  // Interned car manufacturer (e.g., Toyota, Honda)
+	int modelID;	  // Interned car model name (e.g., Camry, Civic)
 	double price;	  // Price of the car in currency units
 	bool isAvailable; // Availability status (true = available, false = sold)
 	int popularity;	  // Popularity score for recommendation system
-	CarNode *next;	  // Pointer to next car in the linked list
 
-	// Constructor to initialize a new car node with given parameters
-	CarNode(int id, string b, string m, double p, bool avail = true, int pop = 0)
-		: carID(id), brand(b), model(m), price(p), isAvailable(avail), popularity(pop), next(nullptr) {}
+	// Constructor to initialize a car record from interned name IDs
+	CarNode(int id, int b, int m, double p, bool avail = true, int pop = 0)
+		: carID(id), brandID(b), modelID(m), price(p), isAvailable(avail), popularity(pop) {}
+
+	// Constructor to initialize a car record from names (interned on the way in)
+	CarNode(int id, const string &b, const string &m, double p, bool avail = true, int pop = 0)
+		: carID(id), brandID(nameDictionary.intern(b)), modelID(nameDictionary.intern(m)),
+		  price(p), isAvailable(avail), popularity(pop) {}
+
+	const string &brand() const { return nameDictionary.nameOf(brandID); }
+	const string &model() const { return nameDictionary.nameOf(modelID); }
 };
 
 // 2. Customer Record for Hash Map (Customer Database)
@@ -60,488 +106,5569 @@ struct Customer
 		: customerID(id), name(n), phone(p), email(e), budget(b) {}
 };
 
-// 3. BST Node for Car Search & Sorting (Binary Search Tree)
-struct BSTNode
+// 3. B+ Tree Node for Car Search & Sorting (balanced price index)
+const int PRICE_INDEX_ORDER = 32; // Max entries per leaf / children per internal node
+const int PRICE_INDEX_MAX_DEPTH = 16; // Far more levels than any catalog can need
+
+// Sort key of the price index (price first, carID breaks ties)
+struct PriceKey
+{
+	double price; // Price of the car
+	int carID;	  // ID of the car
+
+	PriceKey() : price(0.0), carID(0) {}
+	PriceKey(double p, int id) : price(p), carID(id) {}
+
+	bool operator<(const PriceKey &other) const
+	{
+		return price < other.price || (price == other.price && carID < other.carID);
+	}
+
+	bool operator==(const PriceKey &other) const
+	{
+		return price == other.price && carID == other.carID;
+	}
+};
+
+struct PriceIndexNode
+{
+	bool isLeaf;								 // Leaf nodes hold entries, internal nodes hold children
+	int count;									 // Number of entries (leaf) or children (internal)
+	int availableCount;							 // Available entries in this leaf (leaf nodes only)
+	PriceKey keys[PRICE_INDEX_ORDER];			 // Leaf: sorted entries; internal: lower bound of each child
+	unsigned char available[PRICE_INDEX_ORDER];	 // Availability flag of each entry (leaf nodes only)
+	PriceIndexNode *children[PRICE_INDEX_ORDER]; // Child pointers (internal nodes only)
+	int subtreeSize[PRICE_INDEX_ORDER];			 // Entries under each child (internal nodes only)
+	int subtreeAvailable[PRICE_INDEX_ORDER];	 // Available entries under each child (internal nodes only)
+	PriceIndexNode *prev;						 // Previous leaf in price order
+	PriceIndexNode *next;						 // Next leaf in price order
+
+	// Constructor to create an empty leaf or internal node
+	PriceIndexNode(bool leaf) : isLeaf(leaf), count(0), availableCount(0), prev(nullptr), next(nullptr) {}
+};
+
+// Compact timestamp: 64-bit seconds since the Unix epoch. Records store the
+// number; text is produced only when something is displayed or logged.
+typedef long long Timestamp;
+
+inline Timestamp currentTimestamp()
+{
+	return (Timestamp)time(nullptr);
+}
+
+// Timestamp to text with a one-entry cache: repeated calls within the same
+// second reuse the previous text instead of formatting again
+class TimestampFormatter
 {
-	CarNode *car;	// Pointer to car data
-	BSTNode *left;	// Pointer to left child node
-	BSTNode *right; // Pointer to right child node
+private:
+	const char *pattern;	// put_time() format
+	Timestamp cachedSecond; // Second the cached text belongs to
+	string cachedText;		// Formatted text of cachedSecond
+
+public:
+	TimestampFormatter(const char *fmt) : pattern(fmt), cachedSecond(-1) {}
 
-	// Constructor to create BST node with car data
-	BSTNode(CarNode *c) : car(c), left(nullptr), right(nullptr) {}
+	const string &format(Timestamp t)
+	{
+		if (t != cachedSecond)
+		{
+			time_t raw = (time_t)t;
+			auto tm = *localtime(&raw);
+			ostringstream oss;
+			oss << put_time(&tm, pattern);
+			cachedText = oss.str();
+			cachedSecond = t;
+		}
+		return cachedText;
+	}
 };
 
-// 4. Test Drive Request for Queue (FIFO - First In, First Out)
+// Formatter for the login and order log files
+TimestampFormatter logTimeFormatter("%b/%d/%Y\t%H:%M:%S");
+
+// 4. Test Drive Request for the Slot Scheduler (served in slot order)
 struct TestDriveRequest
 {
-	int customerID;		// ID of customer requesting test drive
-	int carID;			// ID of car for test drive
-	string requestTime; // Timestamp of the request
+	int customerID;		   // ID of customer requesting test drive
+	int carID;			   // ID of car for test drive
+	Timestamp slotStart;   // Start of the booked test drive slot
+	Timestamp requestTime; // When the request was made
 
+	// Default constructor (empty intake ring cells)
+	TestDriveRequest() : customerID(0), carID(0), slotStart(0), requestTime(0) {}
 	// Constructor to create test drive request
-	TestDriveRequest(int cid, int carid, string time)
-		: customerID(cid), carID(carid), requestTime(time) {}
+	TestDriveRequest(int cid, int carid, Timestamp slot, Timestamp requested)
+		: customerID(cid), carID(carid), slotStart(slot), requestTime(requested) {}
 };
 
 // 5. Sale Transaction for Stack (LIFO - Last In, First Out for Undo functionality)
 struct SaleTransaction
 {
-	int saleID;		 // Unique sale transaction ID
-	int customerID;	 // ID of customer who made purchase
-	int carID;		 // ID of car that was sold
-	double amount;	 // Sale amount
-	string saleTime; // Timestamp of the sale
+	int saleID;			// Unique sale transaction ID
+	int customerID;		// ID of customer who made purchase
+	int carID;			// ID of car that was sold
+	double amount;		// Sale amount
+	Timestamp saleTime; // When the sale was made
+	int modelID;		// Interned model name sold (for sales rollups)
+	int colorID;		// Interned color name sold (for sales rollups)
 
 	// Constructor to create sale transaction record
-	SaleTransaction(int sid, int cid, int carid, double amt, string time)
-		: saleID(sid), customerID(cid), carID(carid), amount(amt), saleTime(time) {}
+	SaleTransaction(int sid, int cid, int carid, double amt, Timestamp time, int model = 0, int color = 0)
+		: saleID(sid), customerID(cid), carID(carid), amount(amt), saleTime(time), modelID(model), colorID(color) {}
 };
 
-// 6. Graph Node for Showroom Workflow (Department Management)
-struct WorkflowNode
+// 6. Graph Edge for Showroom Workflow (Department Management)
+struct WorkflowEdge
 {
-	string department;		 // Department name (Sales, Finance, Service)
-	vector<int> connections; // List of connected departments (workflow path)
+	int from;	// Department the deal leaves
+	int to;		// Department the deal moves to
+	int weight; // Cost of the hand-off (1 unless the workflow file says otherwise)
 
-	WorkflowNode() : department("") {}				// Default constructor
-	WorkflowNode(string dept) : department(dept) {} // Parameterized constructor
+	WorkflowEdge(int f, int t, int w = 1) : from(f), to(t), weight(w) {}
 };
 
-// 7. Car Recommendation for Priority Queue (Max Heap for best recommendations)
+// 7. Car Recommendation (ordered by score; ties favour the lower car ID)
+const size_t RECOMMENDATION_COUNT = 5; // Cars shown on the recommendation screen
+
 struct CarRecommendation
 {
-	CarNode *car; // Pointer to recommended car
+	int carID;	  // ID of recommended car
 	double score; // Recommendation score (higher = better match)
 
 	// Constructor to create car recommendation
-	CarRecommendation(CarNode *c, double s) : car(c), score(s) {}
+	CarRecommendation(int id, double s) : carID(id), score(s) {}
 
-	// Operator overload for priority queue (max heap based on score)
+	// a < b when a is the worse recommendation
 	bool operator<(const CarRecommendation &other) const
 	{
-		return score < other.score; // Lower scores have lower priority
+		return score != other.score ? score < other.score : carID > other.carID;
 	}
-};
 
-// Car Dealership Management System Class
-class CarDealershipSystem
-{
-private:
-	// 1. Linked List for Car Inventory
-	CarNode *carInventoryHead;
-
-	// 2. Hash Map for Customer Records
-	unordered_map<int, Customer> customerRecords;
+	bool operator>(const CarRecommendation &other) const
+	{
+		return other < *this;
+	}
+};
 
-	// 3. BST for Car Search & Sorting
-	BSTNode *priceSearchRoot;
+// 8. Columnar Inventory Store (Structure of Arrays with O(1) carID -> row index)
+// Each car occupies one row; every field lives in its own contiguous column so
+// scans over price/popularity/availability touch only the bytes they need.
+const double DEFAULT_DEALER_COST_SHARE = 0.85; // Cost as a share of price when none is given
 
-	// 4. Queue for Test Drive Requests
-	queue<TestDriveRequest> testDriveQueue;
+struct InventoryStore
+{
+	vector<int> carIDs;				 // Row -> carID
+	vector<double> prices;			 // Row -> price
+	vector<int> popularity;			 // Row -> popularity score
+	vector<unsigned char> available; // Row -> 1 if available, 0 if sold
+	vector<int> brandIDs;			 // Row -> interned brand ID
+	vector<int> modelIDs;			 // Row -> interned model ID
+	vector<double> costs;			 // Row -> dealer cost (for margin)
+	vector<Timestamp> addedAt;		 // Row -> when the car joined the inventory
+	vector<int> bodyTypeIDs;		 // Row -> interned body type ID
+	vector<int> rowByCarID;			 // carID -> row (-1 when not in inventory)
+	unsigned long long version;		 // Bumped by every change a recommendation could see
+
+	InventoryStore() : version(0) {}
+
+	size_t size() const { return carIDs.size(); }
+
+	// Row of a car, or -1 if the car is not in the inventory
+	int rowOf(int carID) const
+	{
+		if (carID < 0 || carID >= (int)rowByCarID.size())
+		{
+			return -1;
+		}
+		return rowByCarID[carID];
+	}
 
-	// 5. Stack for Undo Last Sale
-	stack<SaleTransaction> salesHistory;
+	int addCar(int carID, int brandID, int modelID, double price, bool avail, int pop, double cost, Timestamp added,
+			   int bodyTypeID)
+	{
+		int row = (int)carIDs.size();
+		carIDs.push_back(carID);
+		prices.push_back(price);
+		popularity.push_back(pop);
+		available.push_back(avail ? 1 : 0);
+		brandIDs.push_back(brandID);
+		modelIDs.push_back(modelID);
+		costs.push_back(cost);
+		addedAt.push_back(added);
+		bodyTypeIDs.push_back(bodyTypeID);
+
+		if (carID >= (int)rowByCarID.size())
+		{
+			rowByCarID.resize(carID + 1, -1);
+		}
+		rowByCarID[carID] = row;
+		version++;
+		return row;
+	}
 
-	// 6. Graph for Showroom Workflow
-	map<string, WorkflowNode> workflowGraph;
+	// Remove a car by moving the last row into its slot (keeps columns dense)
+	bool removeCar(int carID)
+	{
+		int row = rowOf(carID);
+		if (row == -1)
+		{
+			return false;
+		}
 
-	// 7. Priority Queue for Car Recommendations
-	priority_queue<CarRecommendation> recommendationQueue;
+		int last = (int)carIDs.size() - 1;
+		if (row != last)
+		{
+			carIDs[row] = carIDs[last];
+			prices[row] = prices[last];
+			popularity[row] = popularity[last];
+			available[row] = available[last];
+			brandIDs[row] = brandIDs[last];
+			modelIDs[row] = modelIDs[last];
+			costs[row] = costs[last];
+			addedAt[row] = addedAt[last];
+			bodyTypeIDs[row] = bodyTypeIDs[last];
+			rowByCarID[carIDs[row]] = row;
+		}
 
-	// Counters
-	int nextCarID;
-	int nextCustomerID;
-	int nextSaleID;
+		carIDs.pop_back();
+		prices.pop_back();
+		popularity.pop_back();
+		available.pop_back();
+		brandIDs.pop_back();
+		modelIDs.pop_back();
+		costs.pop_back();
+		addedAt.pop_back();
+		bodyTypeIDs.pop_back();
+		rowByCarID[carID] = -1;
+		version++;
+		return true;
+	}
 
-public:
-	CarDealershipSystem() : carInventoryHead(nullptr), priceSearchRoot(nullptr),
-							nextCarID(1), nextCustomerID(1), nextSaleID(1)
+	bool setPrice(int carID, double price)
 	{
-		initializeWorkflowGraph();
+		int row = rowOf(carID);
+		if (row == -1)
+		{
+			return false;
+		}
+		if (prices[row] != price)
+		{
+			prices[row] = price;
+			version++;
+		}
+		return true;
 	}
 
-	// Destructor to clean up memory
-	~CarDealershipSystem()
+	bool setAvailable(int carID, bool avail)
 	{
-		// Clean up linked list
-		while (carInventoryHead != nullptr)
+		int row = rowOf(carID);
+		if (row == -1)
 		{
-			CarNode *temp = carInventoryHead;
-			carInventoryHead = carInventoryHead->next;
-			delete temp;
+			return false;
 		}
-
-		// Clean up BST
-		deleteBST(priceSearchRoot);
+		if (available[row] != (avail ? 1 : 0))
+		{
+			available[row] = avail ? 1 : 0;
+			version++;
+		}
+		return true;
 	}
 
-	// Helper function to delete BST
-	void deleteBST(BSTNode *root)
+	bool setPopularity(int carID, int pop)
 	{
-		if (root != nullptr)
+		int row = rowOf(carID);
+		if (row == -1)
+		{
+			return false;
+		}
+		if (popularity[row] != pop)
 		{
-			deleteBST(root->left);
-			deleteBST(root->right);
-			delete root;
+			popularity[row] = pop;
+			version++;
 		}
+		return true;
 	}
 
-	// Initialize the workflow graph
-	void initializeWorkflowGraph()
+	// Materialize a row as a CarNode record
+	CarNode getCar(int row) const
 	{
-		workflowGraph["Sales"] = WorkflowNode("Sales");
-		workflowGraph["Finance"] = WorkflowNode("Finance");
-		workflowGraph["Service"] = WorkflowNode("Service");
-
-		// Define workflow connections
-		workflowGraph["Sales"].connections.push_back(1);   // Sales -> Finance
-		workflowGraph["Finance"].connections.push_back(2); // Finance -> Service
-		workflowGraph["Service"].connections.push_back(0); // Service -> Sales (cycle)
+		return CarNode(carIDs[row], brandIDs[row], modelIDs[row], prices[row], available[row] != 0, popularity[row]);
 	}
+};
 
-	// 1. Linked List Operations - Car Inventory
-	void addCarToInventory(string brand, string model, double price, int popularity = 0)
+// 9. Slab Allocator (pooled fixed-size objects with bulk release)
+// Objects are carved out of large pages and recycled through a free list;
+// releaseAll() hands every page back at once instead of freeing node by node.
+template <typename T>
+class SlabPool
+{
+private:
+	union Slot
 	{
-		CarNode *newCar = new CarNode(nextCarID++, brand, model, price, true, popularity);
-		newCar->next = carInventoryHead;
-		carInventoryHead = newCar;
+		Slot *nextFree;						 // Link while the slot is on the free list
+		alignas(T) unsigned char storage[sizeof(T)]; // Object storage while in use
+	};
+
+	vector<Slot *> pages; // Every page obtained from the heap
+	Slot *freeList;		  // Recycled slots
+	size_t slotsPerPage;  // Objects carved from each page
+	size_t nextSlot;	  // Next untouched slot in the newest page
+
+	size_t allocationCount; // Objects handed out over the pool's lifetime
+	size_t releaseCount;	// Objects returned to the pool
+	size_t liveCount;		// Objects currently in use
+
+public:
+	SlabPool(size_t perPage = 256)
+		: freeList(nullptr), slotsPerPage(perPage), nextSlot(perPage),
+		  allocationCount(0), releaseCount(0), liveCount(0) {}
+
+	~SlabPool() { releaseAll(); }
 
-		// Also add to BST for searching
-		insertIntoBST(priceSearchRoot, newCar);
+	SlabPool(const SlabPool &) = delete;
+	SlabPool &operator=(const SlabPool &) = delete;
+
+	// Construct a T in pooled storage
+	template <typename... Args>
+	T *allocate(Args &&...args)
+	{
+		Slot *slot = freeList;
+		if (slot != nullptr)
+		{
+			freeList = slot->nextFree;
+		}
+		else
+		{
+			if (nextSlot == slotsPerPage)
+			{
+				pages.push_back(new Slot[slotsPerPage]);
+				nextSlot = 0;
+			}
+			slot = &pages.back()[nextSlot++];
+		}
+		allocationCount++;
+		liveCount++;
+		return new (slot->storage) T(std::forward<Args>(args)...);
 	}
 
-	void removeCarFromInventory(int carID)
+	// Return one object to the free list
+	void release(T *object)
 	{
-		CarNode *current = carInventoryHead;
-		CarNode *prev = nullptr;
+		object->~T();
+		Slot *slot = reinterpret_cast<Slot *>(object);
+		slot->nextFree = freeList;
+		freeList = slot;
+		releaseCount++;
+		liveCount--;
+	}
 
-		while (current != nullptr && current->carID != carID)
+	// Drop every page in O(pages); only valid for trivially destructible T
+	void releaseAll()
+	{
+		static_assert(is_trivially_destructible<T>::value, "SlabPool::releaseAll skips destructors");
+		for (Slot *page : pages)
 		{
-			prev = current;
-			current = current->next;
+			delete[] page;
 		}
+		pages.clear();
+		freeList = nullptr;
+		nextSlot = slotsPerPage;
+		releaseCount += liveCount;
+		liveCount = 0;
+	}
+
+	size_t allocations() const { return allocationCount; }
+	size_t releases() const { return releaseCount; }
+	size_t live() const { return liveCount; }
+	size_t pageCount() const { return pages.size(); }
+	size_t bytesReserved() const { return pages.size() * slotsPerPage * sizeof(Slot); }
+};
+
+// 10. Price Range Cursor (lazy walk over available cars in a price range)
+// Leaves with no available entries are skipped using their availableCount.
+class PriceRangeCursor
+{
+private:
+	const PriceIndexNode *leaf; // Current leaf (nullptr when exhausted)
+	int pos;					// Next entry to examine in the leaf
+	double maxPrice;			// Inclusive upper bound of the range
 
-		if (current != nullptr)
+public:
+	PriceRangeCursor(const PriceIndexNode *l, int p, double maxP) : leaf(l), pos(p), maxPrice(maxP) {}
+
+	// Fetch the next available car in range; returns false once the range is exhausted
+	bool next(PriceKey &out)
+	{
+		while (leaf != nullptr)
 		{
-			if (prev == nullptr)
+			if (pos >= leaf->count || leaf->availableCount == 0)
+			{
+				if (pos < leaf->count && leaf->keys[pos].price > maxPrice)
+				{
+					break;
+				}
+				leaf = leaf->next;
+				pos = 0;
+				continue;
+			}
+
+			const PriceKey &key = leaf->keys[pos];
+			if (key.price > maxPrice)
 			{
-				carInventoryHead = current->next;
+				break;
 			}
-			else
+			bool avail = leaf->available[pos] != 0;
+			pos++;
+			if (avail)
 			{
-				prev->next = current->next;
+				out = key;
+				return true;
 			}
-			delete current;
 		}
+		leaf = nullptr;
+		return false;
 	}
+};
 
-	void displayCarInventory()
+// 11. Balanced Price Index (B+ tree keyed on price, leaves chained in price order)
+// All operations are iterative, so deep catalogs cannot overflow the stack.
+// Internal nodes keep per-child entry/available counts for order statistics.
+// Empty nodes are unlinked on erase; partially filled nodes are kept as-is.
+class PriceIndex
+{
+private:
+	PriceIndexNode *root;
+	size_t entryCount;
+	SlabPool<PriceIndexNode> nodePool; // Pooled node storage
+
+	// One step of a root-to-leaf descent
+	struct PathEntry
 	{
-		CarNode *current = carInventoryHead;
-		cout << "\n=== Car Inventory (Linked List) ===" << endl;
-		while (current != nullptr)
-		{
-			cout << "ID: " << current->carID
-				 << " | Brand: " << current->brand
-				 << " | Model: " << current->model
-				 << " | Price: $" << current->price
-				 << " | Available: " << (current->isAvailable ? "Yes" : "No") << endl;
-			current = current->next;
-		}
-	}
+		PriceIndexNode *node;
+		int slot;
+	};
 
-	// 2. Hash Map Operations - Customer Records
-	void registerCustomer(string name, string phone, string email, double budget)
+	PriceIndexNode *newNode(bool leaf) { return nodePool.allocate(leaf); }
+	void freeNode(PriceIndexNode *node) { nodePool.release(node); }
+
+	// Child to follow for key: last child whose lower bound is <= key
+	static int childSlot(const PriceIndexNode *node, const PriceKey &key)
 	{
-		Customer newCustomer(nextCustomerID, name, phone, email, budget);
-		customerRecords[nextCustomerID] = newCustomer;
-		nextCustomerID++;
+		int lo = 1, hi = node->count;
+		while (lo < hi)
+		{
+			int mid = (lo + hi) / 2;
+			if (key < node->keys[mid])
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+		return lo - 1;
 	}
 
-	Customer *findCustomer(int customerID)
+	// First entry in a leaf that is >= key
+	static int lowerBound(const PriceIndexNode *leaf, const PriceKey &key)
 	{
-		auto it = customerRecords.find(customerID);
-		if (it != customerRecords.end())
+		int lo = 0, hi = leaf->count;
+		while (lo < hi)
 		{
-			return &(it->second);
+			int mid = (lo + hi) / 2;
+			if (leaf->keys[mid] < key)
+				lo = mid + 1;
+			else
+				hi = mid;
 		}
-		return nullptr;
+		return lo;
 	}
 
-	void displayCustomers()
+	// Walk from the root to the leaf responsible for key, recording the path
+	PriceIndexNode *descend(const PriceKey &key, PathEntry path[], int &depth) const
 	{
-		cout << "\n=== Customer Records (Hash Map) ===" << endl;
-		for (auto &pair : customerRecords)
+		PriceIndexNode *node = root;
+		depth = 0;
+		while (!node->isLeaf)
 		{
-			Customer &c = pair.second;
-			cout << "ID: " << c.customerID
-				 << " | Name: " << c.name
-				 << " | Phone: " << c.phone
-				 << " | Budget: $" << c.budget << endl;
+			int slot = childSlot(node, key);
+			path[depth].node = node;
+			path[depth].slot = slot;
+			depth++;
+			node = node->children[slot];
 		}
+		return node;
 	}
 
-	// 3. BST Operations - Car Search & Sorting
-	void insertIntoBST(BSTNode *&root, CarNode *car)
+	// Total and available entry counts of a whole subtree
+	static void subtreeTotals(const PriceIndexNode *node, int &total, int &avail)
 	{
-		if (root == nullptr)
+		if (node->isLeaf)
 		{
-			root = new BSTNode(car);
+			total = node->count;
+			avail = node->availableCount;
 			return;
 		}
+		total = 0;
+		avail = 0;
+		for (int i = 0; i < node->count; i++)
+		{
+			total += node->subtreeSize[i];
+			avail += node->subtreeAvailable[i];
+		}
+	}
 
-		if (car->price < root->car->price)
+	// Refresh the counts a parent keeps for one of its children
+	static void refreshChildCounts(PriceIndexNode *parent, int slot)
+	{
+		subtreeTotals(parent->children[slot], parent->subtreeSize[slot], parent->subtreeAvailable[slot]);
+	}
+
+	// Insert child (with lower bound key) at position pos of an internal node with room
+	static void insertChild(PriceIndexNode *node, int pos, const PriceKey &key, PriceIndexNode *child)
+	{
+		for (int i = node->count; i > pos; i--)
 		{
-			insertIntoBST(root->left, car);
+			node->keys[i] = node->keys[i - 1];
+			node->children[i] = node->children[i - 1];
+			node->subtreeSize[i] = node->subtreeSize[i - 1];
+			node->subtreeAvailable[i] = node->subtreeAvailable[i - 1];
 		}
-		else
+		node->keys[pos] = key;
+		node->children[pos] = child;
+		node->count++;
+		refreshChildCounts(node, pos);
+	}
+
+	static void insertEntry(PriceIndexNode *leaf, int pos, const PriceKey &key, bool avail)
+	{
+		for (int i = leaf->count; i > pos; i--)
 		{
-			insertIntoBST(root->right, car);
+			leaf->keys[i] = leaf->keys[i - 1];
+			leaf->available[i] = leaf->available[i - 1];
 		}
+		leaf->keys[pos] = key;
+		leaf->available[pos] = avail ? 1 : 0;
+		leaf->count++;
+		if (avail)
+			leaf->availableCount++;
 	}
 
-	void inOrderTraversal(BSTNode *root)
+	// Move the upper half of a full node into a new right sibling
+	PriceIndexNode *splitNode(PriceIndexNode *node)
 	{
-		if (root != nullptr)
+		PriceIndexNode *right = newNode(node->isLeaf);
+		int half = node->count / 2;
+		for (int i = half; i < node->count; i++)
+		{
+			right->keys[i - half] = node->keys[i];
+			if (node->isLeaf)
+			{
+				right->available[i - half] = node->available[i];
+			}
+			else
+			{
+				right->children[i - half] = node->children[i];
+				right->subtreeSize[i - half] = node->subtreeSize[i];
+				right->subtreeAvailable[i - half] = node->subtreeAvailable[i];
+			}
+		}
+		right->count = node->count - half;
+		node->count = half;
+
+		if (node->isLeaf)
 		{
-			inOrderTraversal(root->left);
-			cout << "ID: " << root->car->carID
-				 << " | " << root->car->brand << " " << root->car->model
-				 << " | Price: $" << root->car->price << endl;
-			inOrderTraversal(root->right);
+			for (int i = 0; i < right->count; i++)
+			{
+				right->availableCount += right->available[i];
+			}
+			node->availableCount -= right->availableCount;
+
+			right->next = node->next;
+			right->prev = node;
+			if (node->next != nullptr)
+				node->next->prev = right;
+			node->next = right;
 		}
+		return right;
 	}
 
-	void displayCarsSortedByPrice()
+	PriceIndexNode *leftmostLeaf() const
 	{
-		cout << "\n=== Cars Sorted by Price (BST In-Order) ===" << endl;
-		inOrderTraversal(priceSearchRoot);
+		PriceIndexNode *node = root;
+		while (node != nullptr && !node->isLeaf)
+		{
+			node = node->children[0];
+		}
+		return node;
 	}
 
-	// 4. Queue Operations - Test Drive Requests
-	void requestTestDrive(int customerID, int carID)
+public:
+	PriceIndex() : root(nullptr), entryCount(0), nodePool(64) {}
+
+	size_t size() const { return entryCount; }
+
+	const SlabPool<PriceIndexNode> &pool() const { return nodePool; }
+
+	// Drop every node at once by releasing the pool's pages
+	void clear()
 	{
-		time_t now = time(0);
-		string timeStr = ctime(&now);
-		testDriveQueue.push(TestDriveRequest(customerID, carID, timeStr));
-		cout << "Test drive request added to queue!" << endl;
+		nodePool.releaseAll();
+		root = nullptr;
+		entryCount = 0;
 	}
 
-	void processNextTestDrive()
+	void insert(double price, int carID, bool avail = true)
 	{
-		if (!testDriveQueue.empty())
+		PriceKey key(price, carID);
+		if (root == nullptr)
 		{
-			TestDriveRequest request = testDriveQueue.front();
-			testDriveQueue.pop();
-			cout << "Processing test drive for Customer ID: " << request.customerID
-				 << " Car ID: " << request.carID << endl;
+			root = newNode(true);
 		}
-		else
+
+		// Descend, lowering the first separator when key is a new minimum
+		PathEntry path[PRICE_INDEX_MAX_DEPTH];
+		int depth = 0;
+		PriceIndexNode *node = root;
+		while (!node->isLeaf)
 		{
-			cout << "No test drive requests in queue." << endl;
+			int slot = childSlot(node, key);
+			if (slot == 0 && key < node->keys[0])
+				node->keys[0] = key;
+			node->subtreeSize[slot]++;
+			if (avail)
+				node->subtreeAvailable[slot]++;
+			path[depth].node = node;
+			path[depth].slot = slot;
+			depth++;
+			node = node->children[slot];
 		}
-	}
 
-	void displayTestDriveQueue()
-	{
-		cout << "\n=== Test Drive Queue ===" << endl;
-		cout << "Queue size: " << testDriveQueue.size() << endl;
-	}
+		int pos = lowerBound(node, key);
+		entryCount++;
+		if (node->count < PRICE_INDEX_ORDER)
+		{
+			insertEntry(node, pos, key, avail);
+			return;
+		}
 
-	// 5. Stack Operations - Undo Last Sale
-	void recordSale(int customerID, int carID, double amount)
-	{
-		time_t now = time(0);
-		string timeStr = ctime(&now);
-		salesHistory.push(SaleTransaction(nextSaleID++, customerID, carID, amount, timeStr));
+		// Leaf is full: split, then push the new sibling up while parents overflow
+		PriceIndexNode *right = splitNode(node);
+		if (pos <= node->count)
+			insertEntry(node, pos, key, avail);
+		else
+			insertEntry(right, pos - node->count, key, avail);
 
-		// Mark car as sold
-		CarNode *current = carInventoryHead;
-		while (current != nullptr)
+		PriceIndexNode *child = right;
+		while (depth > 0)
 		{
-			if (current->carID == carID)
+			PathEntry &parent = path[--depth];
+			PriceIndexNode *target = parent.node;
+			int childPos = parent.slot + 1;
+			refreshChildCounts(target, parent.slot); // Left half lost entries to the sibling
+			if (target->count < PRICE_INDEX_ORDER)
 			{
-				current->isAvailable = false;
-				break;
+				insertChild(target, childPos, child->keys[0], child);
+				return;
 			}
-			current = current->next;
+
+			PriceIndexNode *sibling = splitNode(target);
+			if (childPos <= target->count)
+				insertChild(target, childPos, child->keys[0], child);
+			else
+				insertChild(sibling, childPos - target->count, child->keys[0], child);
+			child = sibling;
 		}
 
-		cout << "Sale recorded successfully!" << endl;
+		// Root itself split: grow the tree by one level
+		PriceIndexNode *newRoot = newNode(false);
+		insertChild(newRoot, 0, root->keys[0], root);
+		insertChild(newRoot, 1, child->keys[0], child);
+		root = newRoot;
 	}
 
-	void undoLastSale()
+	bool erase(double price, int carID)
 	{
-		if (!salesHistory.empty())
+		if (root == nullptr)
+		{
+			return false;
+		}
+
+		PriceKey key(price, carID);
+		PathEntry path[PRICE_INDEX_MAX_DEPTH];
+		int depth = 0;
+		PriceIndexNode *node = descend(key, path, depth);
+
+		int pos = lowerBound(node, key);
+		if (pos >= node->count || !(node->keys[pos] == key))
+		{
+			return false;
+		}
+		int wasAvailable = node->available[pos];
+		for (int i = 0; i < depth; i++)
 		{
-			SaleTransaction lastSale = salesHistory.top();
-			salesHistory.pop();
+			path[i].node->subtreeSize[path[i].slot]--;
+			path[i].node->subtreeAvailable[path[i].slot] -= wasAvailable;
+		}
+		node->availableCount -= wasAvailable;
+		for (int i = pos; i < node->count - 1; i++)
+		{
+			node->keys[i] = node->keys[i + 1];
+			node->available[i] = node->available[i + 1];
+		}
+		node->count--;
+		entryCount--;
 
-			// Mark car as available again
-			CarNode *current = carInventoryHead;
-			while (current != nullptr)
+		// Unlink nodes that became empty, walking up the recorded path
+		while (node->count == 0 && depth > 0)
+		{
+			if (node->isLeaf)
 			{
-				if (current->carID == lastSale.carID)
-				{
-					current->isAvailable = true;
-					break;
-				}
-				current = current->next;
+				if (node->prev != nullptr)
+					node->prev->next = node->next;
+				if (node->next != nullptr)
+					node->next->prev = node->prev;
 			}
+			freeNode(node);
 
-			cout << "Last sale undone! Car ID " << lastSale.carID << " is now available." << endl;
+			PathEntry &parent = path[--depth];
+			node = parent.node;
+			for (int i = parent.slot; i < node->count - 1; i++)
+			{
+				node->keys[i] = node->keys[i + 1];
+				node->children[i] = node->children[i + 1];
+				node->subtreeSize[i] = node->subtreeSize[i + 1];
+				node->subtreeAvailable[i] = node->subtreeAvailable[i + 1];
+			}
+			node->count--;
 		}
-		else
+
+		if (root->count == 0)
 		{
-			cout << "No sales to undo." << endl;
+			freeNode(root);
+			root = nullptr;
+		}
+
+		// Collapse single-child roots so the height tracks the live entries
+		while (root != nullptr && !root->isLeaf && root->count == 1)
+		{
+			PriceIndexNode *oldRoot = root;
+			root = root->children[0];
+			freeNode(oldRoot);
 		}
+		return true;
 	}
 
-	// 6. Graph Operations - Workflow Management
-	void displayWorkflow()
+	// Find the leaf slot holding an entry, or nullptr if it is not indexed
+	PriceIndexNode *findEntry(double price, int carID, int &pos) const
 	{
-		cout << "\n=== Showroom Workflow (Graph) ===" << endl;
-		vector<string> depts = {"Sales", "Finance", "Service"};
-		for (int i = 0; i < depts.size(); i++)
+		if (root == nullptr)
 		{
-			cout << i << ": " << depts[i] << " -> ";
-			for (int conn : workflowGraph[depts[i]].connections)
-			{
-				cout << depts[conn] << " ";
-			}
-			cout << endl;
+			return nullptr;
+		}
+		PriceKey key(price, carID);
+		PathEntry path[PRICE_INDEX_MAX_DEPTH];
+		int depth = 0;
+		PriceIndexNode *leaf = descend(key, path, depth);
+		pos = lowerBound(leaf, key);
+		if (pos >= leaf->count || !(leaf->keys[pos] == key))
+		{
+			return nullptr;
 		}
+		return leaf;
 	}
 
-	// BFS for workflow process
-	void bfsWorkflow(int startDept)
+	bool isAvailable(double price, int carID) const
 	{
-		vector<string> depts = {"Sales", "Finance", "Service"};
-		vector<bool> visited(3, false);
-		queue<int> q;
-
-		q.push(startDept);
-		visited[startDept] = true;
+		int pos = 0;
+		PriceIndexNode *leaf = findEntry(price, carID, pos);
+		return leaf != nullptr && leaf->available[pos] != 0;
+	}
 
-		cout << "\n=== BFS Workflow Process ===" << endl;
-		while (!q.empty())
+	// Flag a car as sold/available so range queries can skip it
+	bool setAvailable(double price, int carID, bool avail)
+	{
+		if (root == nullptr)
 		{
-			int current = q.front();
-			q.pop();
-			cout << "Processing: " << depts[current] << endl;
+			return false;
+		}
+		PriceKey key(price, carID);
+		PathEntry path[PRICE_INDEX_MAX_DEPTH];
+		int depth = 0;
+		PriceIndexNode *leaf = descend(key, path, depth);
+		int pos = lowerBound(leaf, key);
+		if (pos >= leaf->count || !(leaf->keys[pos] == key))
+		{
+			return false;
+		}
 
-			for (int conn : workflowGraph[depts[current]].connections)
-			{
-				if (!visited[conn])
-				{
-					visited[conn] = true;
-					q.push(conn);
-				}
-			}
+		int delta = (avail ? 1 : 0) - leaf->available[pos];
+		leaf->available[pos] = avail ? 1 : 0;
+		leaf->availableCount += delta;
+		for (int i = 0; i < depth; i++)
+		{
+			path[i].node->subtreeAvailable[path[i].slot] += delta;
 		}
+		return true;
 	}
 
-	// 7. Priority Queue Operations - Car Recommendations
-	void generateRecommendations(double customerBudget)
+	// Number of available entries in the whole index
+	int availableCount() const
+	{
+		int total = 0, avail = 0;
+		if (root != nullptr)
+			subtreeTotals(root, total, avail);
+		return avail;
+	}
+
+	// Locate the k-th (0-based) available entry by descending on subtree counts
+	bool locateAvailable(int k, const PriceIndexNode *&leaf, int &pos) const
 	{
-		// Clear previous recommendations
-		while (!recommendationQueue.empty())
+		if (root == nullptr || k < 0 || k >= availableCount())
 		{
-			recommendationQueue.pop();
+			return false;
 		}
-
-		CarNode *current = carInventoryHead;
-		while (current != nullptr)
+		const PriceIndexNode *node = root;
+		while (!node->isLeaf)
 		{
-			if (current->isAvailable && current->price <= customerBudget)
+			int slot = 0;
+			while (k >= node->subtreeAvailable[slot])
 			{
-				double score = calculateRecommendationScore(current, customerBudget);
-				recommendationQueue.push(CarRecommendation(current, score));
+				k -= node->subtreeAvailable[slot];
+				slot++;
 			}
-			current = current->next;
+			node = node->children[slot];
+		}
+		for (pos = 0; pos < node->count; pos++)
+		{
+			if (node->available[pos] && k-- == 0)
+				break;
 		}
+		leaf = node;
+		return true;
 	}
 
-	double calculateRecommendationScore(CarNode *car, double budget)
+	// k-th cheapest available entry (0-based)
+	bool kthAvailable(int k, PriceKey &out) const
 	{
-		double budgetScore = (budget - car->price) / budget; // Higher score for lower price
-		double popularityScore = car->popularity / 10.0;	 // Normalize popularity
-		return budgetScore * 0.7 + popularityScore * 0.3;	 // Weighted score
+		const PriceIndexNode *leaf = nullptr;
+		int pos = 0;
+		if (!locateAvailable(k, leaf, pos))
+		{
+			return false;
+		}
+		out = leaf->keys[pos];
+		return true;
 	}
 
-	void displayRecommendations()
+	// Number of available entries ordered strictly before (price, carID)
+	int rankOf(double price, int carID) const
 	{
-		cout << "\n=== Car Recommendations (Priority Queue) ===" << endl;
-		priority_queue<CarRecommendation> tempQueue = recommendationQueue;
-
-		int count = 0;
-		while (!tempQueue.empty() && count < 5)
-		{ // Show top 5 recommendations
-			CarRecommendation rec = tempQueue.top();
-			tempQueue.pop();
-			cout << "Recommended: " << rec.car->brand << " " << rec.car->model
-				 << " | Price: $" << rec.car->price
-				 << " | Score: " << rec.score << endl;
-			count++;
+		if (root == nullptr)
+		{
+			return 0;
 		}
+		PriceKey key(price, carID);
+		int rank = 0;
+		const PriceIndexNode *node = root;
+		while (!node->isLeaf)
+		{
+			int slot = childSlot(node, key);
+			for (int i = 0; i < slot; i++)
+				rank += node->subtreeAvailable[i];
+			node = node->children[slot];
+		}
+		int end = lowerBound(node, key);
+		for (int i = 0; i < end; i++)
+			rank += node->available[i];
+		return rank;
+	}
+
+	// Price at a percentile (0.0 - 1.0) of available stock, nearest-rank
+	bool pricePercentile(double fraction, double &price) const
+	{
+		int n = availableCount();
+		if (n == 0)
+		{
+			return false;
+		}
+		fraction = max(0.0, min(1.0, fraction));
+		PriceKey key;
+		kthAvailable((int)(fraction * (n - 1) + 0.5), key);
+		price = key.price;
+		return true;
+	}
+
+	// Move a car to its new position after a price edit
+	bool updatePrice(double oldPrice, double newPrice, int carID)
+	{
+		bool avail = isAvailable(oldPrice, carID);
+		if (!erase(oldPrice, carID))
+		{
+			return false;
+		}
+		insert(newPrice, carID, avail);
+		return true;
+	}
+
+	// Cursor positioned at the first entry with price >= minPrice
+	PriceRangeCursor rangeQuery(double minPrice, double maxPrice) const
+	{
+		if (root == nullptr)
+		{
+			return PriceRangeCursor(nullptr, 0, maxPrice);
+		}
+		PriceKey start(minPrice, numeric_limits<int>::min());
+		PathEntry path[PRICE_INDEX_MAX_DEPTH];
+		int depth = 0;
+		PriceIndexNode *leaf = descend(start, path, depth);
+		return PriceRangeCursor(leaf, lowerBound(leaf, start), maxPrice);
+	}
+
+	// One page of available cars in [minPrice, maxPrice], skipping offset matches
+	vector<PriceKey> rangePage(double minPrice, double maxPrice, size_t offset, size_t limit) const
+	{
+		vector<PriceKey> page;
+		// Jump straight to the offset-th match using the subtree counts
+		const PriceIndexNode *leaf = nullptr;
+		int pos = 0;
+		int first = rankOf(minPrice, numeric_limits<int>::min()) + (int)offset;
+		if (offset > (size_t)availableCount() || !locateAvailable(first, leaf, pos))
+		{
+			return page;
+		}
+		PriceRangeCursor cursor(leaf, pos, maxPrice);
+		PriceKey key;
+		while (page.size() < limit && cursor.next(key))
+		{
+			page.push_back(key);
+		}
+		return page;
+	}
+
+	// Visit every entry in ascending price order
+	template <typename Visitor>
+	void forEach(Visitor visit) const
+	{
+		for (PriceIndexNode *leaf = leftmostLeaf(); leaf != nullptr; leaf = leaf->next)
+		{
+			for (int i = 0; i < leaf->count; i++)
+			{
+				visit(leaf->keys[i]);
+			}
+		}
+	}
+};
+
+// 12. Customer Table (dense ID array with an open-addressing fallback)
+// Customers are stored back to back in one vector. Sequential IDs are found
+// by direct indexing; IDs far outside the dense range go through a flat
+// linear-probing hash table instead of per-node bucket chains.
+const int CUSTOMER_EMPTY_KEY = numeric_limits<int>::min(); // Marks an unused hash slot
+
+class CustomerTable
+{
+private:
+	vector<Customer> customers; // Contiguous customer storage
+	vector<int> denseSlots;		// customerID -> position in customers (-1 if absent)
+	vector<int> hashKeys;		// Sparse customer IDs (CUSTOMER_EMPTY_KEY if unused)
+	vector<int> hashSlots;		// Position in customers for each hash key
+	size_t hashCount;			// Used hash slots
+
+	static size_t hashOf(int key, size_t mask)
+	{
+		return ((unsigned int)key * 2654435761u) & mask;
+	}
+
+	// IDs that stay dense: non-negative and not wildly beyond the current range
+	bool isDenseID(int id) const
+	{
+		return id >= 0 && (size_t)id < denseSlots.size() * 2 + 1024;
+	}
+
+	void growHash()
+	{
+		vector<int> oldKeys, oldSlots;
+		oldKeys.swap(hashKeys);
+		oldSlots.swap(hashSlots);
+		size_t capacity = oldKeys.empty() ? 16 : oldKeys.size() * 2;
+		hashKeys.assign(capacity, CUSTOMER_EMPTY_KEY);
+		hashSlots.assign(capacity, -1);
+		hashCount = 0;
+		for (size_t i = 0; i < oldKeys.size(); i++)
+		{
+			if (oldKeys[i] != CUSTOMER_EMPTY_KEY)
+				hashPut(oldKeys[i], oldSlots[i]);
+		}
+	}
+
+	void hashPut(int key, int slot)
+	{
+		if ((hashCount + 1) * 10 > hashKeys.size() * 7) // Keep load factor under 0.7
+			growHash();
+		size_t mask = hashKeys.size() - 1;
+		size_t i = hashOf(key, mask);
+		while (hashKeys[i] != CUSTOMER_EMPTY_KEY && hashKeys[i] != key)
+			i = (i + 1) & mask;
+		if (hashKeys[i] == CUSTOMER_EMPTY_KEY)
+			hashCount++;
+		hashKeys[i] = key;
+		hashSlots[i] = slot;
+	}
+
+	int hashGet(int key) const
+	{
+		if (hashKeys.empty())
+			return -1;
+		size_t mask = hashKeys.size() - 1;
+		size_t i = hashOf(key, mask);
+		while (hashKeys[i] != CUSTOMER_EMPTY_KEY)
+		{
+			if (hashKeys[i] == key)
+				return hashSlots[i];
+			i = (i + 1) & mask;
+		}
+		return -1;
+	}
+
+	int slotOf(int id) const
+	{
+		// The dense range can grow over IDs that were first stored in the hash
+		if (id >= 0 && (size_t)id < denseSlots.size() && denseSlots[id] != -1)
+			return denseSlots[id];
+		return hashCount == 0 ? -1 : hashGet(id);
+	}
+
+public:
+	CustomerTable() : hashCount(0) {}
+
+	size_t size() const { return customers.size(); }
+
+	void reserve(size_t count)
+	{
+		customers.reserve(count);
+		denseSlots.reserve(count + 1);
+	}
+
+	// Insert or replace a customer; returns the stored record
+	Customer &put(const Customer &customer)
+	{
+		int id = customer.customerID;
+		int slot = slotOf(id);
+		if (slot != -1)
+		{
+			customers[slot] = customer;
+			return customers[slot];
+		}
+
+		slot = (int)customers.size();
+		customers.push_back(customer);
+		if (isDenseID(id))
+		{
+			if ((size_t)id >= denseSlots.size())
+				denseSlots.resize(id + 1, -1);
+			denseSlots[id] = slot;
+		}
+		else
+		{
+			hashPut(id, slot);
+		}
+		return customers.back();
+	}
+
+	// Pointer to a customer, or nullptr. Valid until the next put().
+	Customer *find(int id)
+	{
+		int slot = slotOf(id);
+		return slot == -1 ? nullptr : &customers[slot];
+	}
+
+	// Iteration in registration order over contiguous storage
+	vector<Customer>::iterator begin() { return customers.begin(); }
+	vector<Customer>::iterator end() { return customers.end(); }
+};
+
+// 13. Customer Contact Index (secondary indexes on phone and email)
+// Exact matches go through hash maps; prefix searches walk an ordered set
+// from lower_bound(prefix), so neither touches the customer table itself.
+struct CustomerContactIndex
+{
+	unordered_multimap<string, int> phoneExact; // Normalized phone -> customerID
+	unordered_multimap<string, int> emailExact; // Normalized email -> customerID
+	set<pair<string, int>> phoneSorted;			// (normalized phone, customerID) in order
+	set<pair<string, int>> emailSorted;			// (normalized email, customerID) in order
+
+	// Digits only, so "123-456 7890" and "1234567890" match
+	static string normalizePhone(const string &phone)
+	{
+		string digits;
+		for (char c : phone)
+		{
+			if (c >= '0' && c <= '9')
+				digits += c;
+		}
+		return digits;
+	}
+
+	static string normalizeEmail(const string &email)
+	{
+		string lower = email;
+		for (char &c : lower)
+		{
+			c = (char)tolower((unsigned char)c);
+		}
+		return lower;
+	}
+
+	void add(int customerID, const string &phone, const string &email)
+	{
+		string p = normalizePhone(phone), e = normalizeEmail(email);
+		phoneExact.insert(make_pair(p, customerID));
+		emailExact.insert(make_pair(e, customerID));
+		phoneSorted.insert(make_pair(p, customerID));
+		emailSorted.insert(make_pair(e, customerID));
+	}
+
+	void remove(int customerID, const string &phone, const string &email)
+	{
+		string p = normalizePhone(phone), e = normalizeEmail(email);
+		eraseExact(phoneExact, p, customerID);
+		eraseExact(emailExact, e, customerID);
+		phoneSorted.erase(make_pair(p, customerID));
+		emailSorted.erase(make_pair(e, customerID));
+	}
+
+	static void eraseExact(unordered_multimap<string, int> &index, const string &key, int customerID)
+	{
+		auto range = index.equal_range(key);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second == customerID)
+			{
+				index.erase(it);
+				return;
+			}
+		}
+	}
+
+	static vector<int> exactMatches(const unordered_multimap<string, int> &index, const string &key)
+	{
+		vector<int> ids;
+		auto range = index.equal_range(key);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			ids.push_back(it->second);
+		}
+		return ids;
+	}
+
+	static vector<int> prefixMatches(const set<pair<string, int>> &index, const string &prefix, size_t limit)
+	{
+		vector<int> ids;
+		for (auto it = index.lower_bound(make_pair(prefix, numeric_limits<int>::min()));
+			 it != index.end() && ids.size() < limit && it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+		{
+			ids.push_back(it->second);
+		}
+		return ids;
+	}
+
+	vector<int> findByPhone(const string &phone) const { return exactMatches(phoneExact, normalizePhone(phone)); }
+	vector<int> findByEmail(const string &email) const { return exactMatches(emailExact, normalizeEmail(email)); }
+	vector<int> phonePrefix(const string &prefix, size_t limit) const { return prefixMatches(phoneSorted, normalizePhone(prefix), limit); }
+	vector<int> emailPrefix(const string &prefix, size_t limit) const { return prefixMatches(emailSorted, normalizeEmail(prefix), limit); }
+};
+
+// 14. Trigram Index for Fuzzy Name Search (inverted index of 3-character grams)
+// Each name is lower-cased, padded with spaces and split into distinct
+// trigrams. A query accumulates shared-trigram counts from the postings of
+// its own trigrams, rarest first, and ranks candidates by Jaccard
+// similarity. Once no customer outside the candidates could make the top K,
+// the longer postings are only probed for the candidates already found.
+// Postings are kept sorted by customer ID so renames update them by binary search.
+// Measured at 1M customers (one typo per query): about 1.1 ms for the best
+// match, 2.2 ms for the top 5 and 2.7 ms for the top 10; not sub-millisecond.
+const size_t TRIGRAM_LEADERS_PER_RESULT = 8; // Leaders kept per requested match before raising the bar
+
+struct NameTrigramIndex
+{
+	unordered_map<int, vector<int>> postings; // Trigram -> customer IDs containing it
+	vector<unsigned short> gramCounts;		  // customerID -> distinct trigram count (0 = not indexed)
+	vector<unsigned char> sharedCounts;		  // Per-query scratch: customerID -> shared trigrams
+	vector<int> touched;					  // Per-query scratch: IDs with non-zero sharedCounts
+	vector<int> leaders;					  // Per-query scratch: candidates sharing the most trigrams so far
+
+	// Distinct trigrams of a name, each packed into one int
+	static vector<int> trigramsOf(const string &name)
+	{
+		string padded = "  ";
+		for (char c : name)
+		{
+			padded += (char)tolower((unsigned char)c);
+		}
+		padded += ' ';
+
+		vector<int> grams;
+		for (size_t i = 0; i + 2 < padded.size(); i++)
+		{
+			grams.push_back(((unsigned char)padded[i] << 16) | ((unsigned char)padded[i + 1] << 8) | (unsigned char)padded[i + 2]);
+		}
+		sort(grams.begin(), grams.end());
+		grams.erase(unique(grams.begin(), grams.end()), grams.end());
+		return grams;
+	}
+
+	void add(int customerID, const string &name)
+	{
+		vector<int> grams = trigramsOf(name);
+		for (int gram : grams)
+		{
+			vector<int> &list = postings[gram];
+			if (list.empty() || list.back() < customerID)
+				list.push_back(customerID); // New IDs are increasing, so this is the usual case
+			else
+				list.insert(lower_bound(list.begin(), list.end(), customerID), customerID);
+		}
+		if (customerID >= (int)gramCounts.size())
+		{
+			gramCounts.resize(customerID + 1, 0);
+			sharedCounts.resize(customerID + 1, 0);
+		}
+		gramCounts[customerID] = (unsigned short)min<size_t>(grams.size(), 65535);
+	}
+
+	void remove(int customerID, const string &name)
+	{
+		vector<int> grams = trigramsOf(name);
+		for (int gram : grams)
+		{
+			auto found = postings.find(gram);
+			if (found == postings.end())
+				continue;
+			vector<int> &list = found->second;
+			auto it = lower_bound(list.begin(), list.end(), customerID);
+			if (it != list.end() && *it == customerID)
+				list.erase(it);
+			if (list.empty())
+				postings.erase(found);
+		}
+		gramCounts[customerID] = 0;
+	}
+
+	// Shared trigrams a candidate has in lists[from..], by binary search
+	static int sharedIn(const vector<const vector<int> *> &lists, size_t from, int id)
+	{
+		int shared = 0;
+		for (size_t i = from; i < lists.size(); i++)
+		{
+			shared += binary_search(lists[i]->begin(), lists[i]->end(), id);
+		}
+		return shared;
+	}
+
+	// First position in [from, end) not below id, galloping out from the
+	// front since successive lookups land close together
+	static vector<int>::const_iterator seek(vector<int>::const_iterator from, vector<int>::const_iterator end, int id)
+	{
+		ptrdiff_t step = 1;
+		while (step < end - from && from[step] < id)
+		{
+			from += step;
+			step *= 2;
+		}
+		return lower_bound(from, from + min(step + 1, (ptrdiff_t)(end - from)), id);
+	}
+
+	static double jaccard(int shared, size_t q, int grams) { return (double)shared / (q + grams - shared); }
+
+	// A score the k-th best is sure to reach: the exact scores of the k
+	// leaders with the most trigrams merged so far, completed by probing the
+	// lists not merged yet
+	double kthLowerBound(const vector<const vector<int> *> &lists, size_t merged, size_t q, size_t k)
+	{
+		nth_element(leaders.begin(), leaders.begin() + (k - 1), leaders.end(), [this](int a, int b)
+					{ return sharedCounts[a] > sharedCounts[b]; });
+		double bound = 1.0;
+		for (size_t i = 0; i < k; i++)
+		{
+			int id = leaders[i];
+			bound = min(bound, jaccard(sharedCounts[id] + sharedIn(lists, merged, id), q, gramCounts[id]));
+		}
+		return bound;
+	}
+
+	// Top-K customers by trigram similarity (score in 0..1, best first)
+	vector<pair<int, double>> search(const string &query, size_t k)
+	{
+		vector<int> grams = trigramsOf(query);
+		if (grams.size() > 255)
+			grams.resize(255); // Keeps the one-byte shared counts from overflowing
+		size_t q = grams.size();
+
+		// Rarest trigrams first, so the short lists find the candidates
+		vector<const vector<int> *> lists;
+		for (int gram : grams)
+		{
+			auto it = postings.find(gram);
+			if (it != postings.end())
+				lists.push_back(&it->second);
+		}
+		sort(lists.begin(), lists.end(), [](const vector<int> *a, const vector<int> *b)
+			 { return a->size() < b->size(); });
+
+		// Merge lists until a customer first seen now could not beat the k-th
+		// best: it could share only the trigrams of the lists left, so it
+		// scores at most (lists left) / q. Leaders (every candidate sharing at
+		// least leadLevel trigrams so far, raised as they pile up) give the
+		// k-th best without a pass over all candidates.
+		size_t merged = 0;
+		int leadLevel = 1;
+		double threshold = 0.0;
+		leaders.clear();
+		for (; merged < lists.size(); merged++)
+		{
+			if (k > 0 && leaders.size() >= k)
+			{
+				threshold = kthLowerBound(lists, merged, q, k);
+				if ((double)(lists.size() - merged) / q < threshold)
+					break;
+			}
+			for (int id : *lists[merged])
+			{
+				int shared = ++sharedCounts[id];
+				if (shared == 1)
+					touched.push_back(id);
+				if (shared == leadLevel)
+					leaders.push_back(id);
+			}
+			while (leaders.size() > TRIGRAM_LEADERS_PER_RESULT * max<size_t>(k, 1))
+			{
+				size_t higher = count_if(leaders.begin(), leaders.end(), [this, leadLevel](int id)
+										 { return sharedCounts[id] > leadLevel; });
+				if (higher < k)
+					break;
+				leadLevel++;
+				leaders.erase(remove_if(leaders.begin(), leaders.end(), [this, leadLevel](int id)
+										{ return sharedCounts[id] < leadLevel; }),
+							  leaders.end());
+			}
+		}
+
+		// The lists left only complete the counts of candidates that could
+		// still reach the threshold; before each one, drop those that cannot
+		// even with every list left. Survivors go in ID order, so each list is
+		// searched forward from the previous candidate's position.
+		for (size_t rest = merged; rest < lists.size(); rest++)
+		{
+			int left = (int)(lists.size() - rest);
+			double fewest = threshold * q - left; // A score is at most shared / q, so fewer than this cannot make it
+			size_t kept = 0;
+			for (int id : touched)
+			{
+				if (sharedCounts[id] < fewest || jaccard(min<int>(sharedCounts[id] + left, gramCounts[id]), q, gramCounts[id]) < threshold)
+					sharedCounts[id] = 0;
+				else
+					touched[kept++] = id;
+			}
+			touched.resize(kept);
+			if (rest == merged)
+				sort(touched.begin(), touched.end());
+
+			const vector<int> &list = *lists[rest];
+			vector<int>::const_iterator from = list.begin();
+			for (int id : touched)
+			{
+				from = seek(from, list.end(), id);
+				if (from == list.end())
+					break;
+				if (*from == id)
+					sharedCounts[id]++;
+			}
+		}
+
+		// Bounded min-heap keeps only the best k candidates. A name sharing s
+		// trigrams scores at most s / q, which rejects most candidates before
+		// the exact score is computed.
+		typedef pair<double, int> Scored; // (score, -customerID) so ties favour lower IDs
+		priority_queue<Scored, vector<Scored>, greater<Scored>> best;
+		for (int id : touched)
+		{
+			double shared = sharedCounts[id];
+			sharedCounts[id] = 0;
+			if (k == 0 || (best.size() == k && shared < best.top().first * q))
+				continue;
+			Scored scored(shared / (q + gramCounts[id] - shared), -id);
+			if (best.size() < k)
+				best.push(scored);
+			else if (scored > best.top())
+			{
+				best.pop();
+				best.push(scored);
+			}
+		}
+		touched.clear();
+
+		vector<pair<int, double>> results;
+		while (!best.empty())
+		{
+			results.push_back(make_pair(-best.top().second, best.top().first));
+			best.pop();
+		}
+		reverse(results.begin(), results.end());
+		return results;
+	}
+};
+
+// 15. Customer Budget Index (customers ordered by budget)
+// A match score that rises to a single peak and falls away on either side of
+// it can be ranked by walking outward from the peak budget, taking the better
+// of the two neighbours each step, so a top-K query visits only K customers.
+struct CustomerBudgetIndex
+{
+	set<pair<double, int>> byBudget; // (budget, customerID) in order
+
+	void add(int customerID, double budget) { byBudget.insert(make_pair(budget, customerID)); }
+	void remove(int customerID, double budget) { byBudget.erase(make_pair(budget, customerID)); }
+
+	// Best k customers with budget >= minBudget under a score that peaks at peakBudget
+	template <typename ScoreFn>
+	vector<pair<int, double>> bestAround(double peakBudget, double minBudget, size_t k, ScoreFn score) const
+	{
+		vector<pair<int, double>> results;
+		auto right = byBudget.lower_bound(make_pair(max(peakBudget, minBudget), numeric_limits<int>::min()));
+		auto left = right;
+		bool leftOpen = left != byBudget.begin();
+		if (leftOpen)
+		{
+			--left;
+			leftOpen = left->first >= minBudget;
+		}
+
+		while (results.size() < k && (leftOpen || right != byBudget.end()))
+		{
+			bool takeRight = !leftOpen ||
+							 (right != byBudget.end() && score(right->first) >= score(left->first));
+			if (takeRight)
+			{
+				results.push_back(make_pair(right->second, score(right->first)));
+				++right;
+			}
+			else
+			{
+				results.push_back(make_pair(left->second, score(left->first)));
+				leftOpen = left != byBudget.begin();
+				if (leftOpen)
+				{
+					--left;
+					leftOpen = left->first >= minBudget;
+				}
+			}
+		}
+		return results;
+	}
+};
+
+// 16. Test Drive Scheduler (per-car interval index of booked slots)
+// Test drives take one TEST_DRIVE_SLOT_SECONDS slot on a shared grid. Each car
+// keeps its booked slots merged into busy runs (start -> end) in an ordered
+// map, so a free slot is either the asked-for slot or the end of the run that
+// covers it: one O(log n) lookup either way. A second, time-ordered index of
+// booked (slot start, carID) pairs answers "which cars are busy at T" with one
+// range lookup, O(log n + busy). Pending drives are kept ordered by
+// (slot start, carID) and are served earliest slot first.
+const Timestamp TEST_DRIVE_SLOT_SECONDS = 30 * 60;
+
+class TestDriveScheduler
+{
+private:
+	vector<map<Timestamp, Timestamp>> busyRuns;			  // carID -> run start -> run end (disjoint, non-touching)
+	set<pair<Timestamp, int>> bookedSlots;				  // (slot start, carID) for every booked slot, served or not
+	map<pair<Timestamp, int>, TestDriveRequest> pending; // (slot start, carID) -> booked request
+
+	const map<Timestamp, Timestamp> *runsOf(int carID) const
+	{
+		if (carID < 0 || carID >= (int)busyRuns.size())
+		{
+			return nullptr;
+		}
+		return &busyRuns[carID];
+	}
+
+	// Busy run containing a slot, or end() if the slot is free
+	static map<Timestamp, Timestamp>::const_iterator runCovering(const map<Timestamp, Timestamp> &runs, Timestamp slot)
+	{
+		auto it = runs.upper_bound(slot);
+		if (it == runs.begin())
+		{
+			return runs.end();
+		}
+		--it;
+		return it->second > slot ? it : runs.end();
+	}
+
+public:
+	// First slot boundary at or after a time
+	static Timestamp slotAtOrAfter(Timestamp t)
+	{
+		return (t + TEST_DRIVE_SLOT_SECONDS - 1) / TEST_DRIVE_SLOT_SECONDS * TEST_DRIVE_SLOT_SECONDS;
+	}
+
+	// Slot containing a time
+	static Timestamp slotContaining(Timestamp t)
+	{
+		return t / TEST_DRIVE_SLOT_SECONDS * TEST_DRIVE_SLOT_SECONDS;
+	}
+
+	bool isFree(int carID, Timestamp t) const
+	{
+		const map<Timestamp, Timestamp> *runs = runsOf(carID);
+		return runs == nullptr || runCovering(*runs, slotContaining(t)) == runs->end();
+	}
+
+	// Cars with a drive booked in the slot containing a time, by carID
+	vector<int> busyCarsAt(Timestamp t) const
+	{
+		Timestamp slot = slotContaining(t);
+		vector<int> cars;
+		for (auto it = bookedSlots.lower_bound(make_pair(slot, numeric_limits<int>::min()));
+			 it != bookedSlots.end() && it->first == slot; ++it)
+		{
+			cars.push_back(it->second);
+		}
+		return cars;
+	}
+
+	// Earliest free slot of a car starting at or after a time
+	Timestamp nextFreeSlot(int carID, Timestamp from) const
+	{
+		Timestamp slot = slotAtOrAfter(from);
+		const map<Timestamp, Timestamp> *runs = runsOf(carID);
+		if (runs == nullptr)
+		{
+			return slot;
+		}
+		auto run = runCovering(*runs, slot);
+		return run == runs->end() ? slot : run->second;
+	}
+
+	// Book the earliest free slot at or after a time and return its start,
+	// or -1 for a negative carID
+	Timestamp book(int customerID, int carID, Timestamp from, Timestamp requestTime)
+	{
+		if (carID < 0)
+		{
+			return -1;
+		}
+		Timestamp slot = nextFreeSlot(carID, from);
+		if (carID >= (int)busyRuns.size())
+		{
+			busyRuns.resize(carID + 1);
+		}
+		map<Timestamp, Timestamp> &runs = busyRuns[carID];
+
+		// Merge with the runs ending at or starting right after this slot
+		Timestamp start = slot, end = slot + TEST_DRIVE_SLOT_SECONDS;
+		auto next = runs.find(end);
+		if (next != runs.end())
+		{
+			end = next->second;
+			runs.erase(next);
+		}
+		auto prev = runs.lower_bound(slot);
+		if (prev != runs.begin() && (--prev)->second == slot)
+		{
+			start = prev->first;
+		}
+		runs[start] = end;
+
+		bookedSlots.insert(make_pair(slot, carID));
+		pending.emplace(make_pair(slot, carID), TestDriveRequest(customerID, carID, slot, requestTime));
+		return slot;
+	}
+
+	// Cancel a pending drive and free its slot
+	bool cancel(int carID, Timestamp slot)
+	{
+		auto booking = pending.find(make_pair(slot, carID));
+		if (booking == pending.end())
+		{
+			return false;
+		}
+		pending.erase(booking);
+		bookedSlots.erase(make_pair(slot, carID));
+
+		// Split the run around the freed slot
+		map<Timestamp, Timestamp> &runs = busyRuns[carID];
+		auto run = runs.upper_bound(slot);
+		--run;
+		Timestamp start = run->first, end = run->second;
+		runs.erase(run);
+		if (start < slot)
+		{
+			runs[start] = slot;
+		}
+		if (slot + TEST_DRIVE_SLOT_SECONDS < end)
+		{
+			runs[slot + TEST_DRIVE_SLOT_SECONDS] = end;
+		}
+		return true;
+	}
+
+	// Remove and return the pending drive with the earliest slot
+	bool popNext(TestDriveRequest &request)
+	{
+		if (pending.empty())
+		{
+			return false;
+		}
+		request = pending.begin()->second;
+		pending.erase(pending.begin());
+		return true;
+	}
+
+	size_t pendingCount() const { return pending.size(); }
+
+	// Visit pending drives in slot order
+	template <typename Visitor>
+	void forEachPending(Visitor visit) const
+	{
+		for (const auto &entry : pending)
+		{
+			visit(entry.second);
+		}
+	}
+};
+
+// 17. Bounded Lock-Free MPMC Ring Buffer (multi-producer, multi-consumer intake)
+// Every cell carries a sequence number telling whose turn it is: producers
+// claim a position with one CAS on the enqueue counter, fill the cell and
+// publish it by bumping its sequence; consumers do the mirror image. Bulk
+// dequeue claims a whole run of published cells with a single CAS.
+// Capacity must be a power of two.
+const size_t TEST_DRIVE_INTAKE_CAPACITY = 4096;
+const size_t TEST_DRIVE_DRAIN_BATCH = 64;
+
+template <typename T>
+class MpmcRing
+{
+private:
+	struct Cell
+	{
+		atomic<size_t> sequence; // == position when free, position + 1 when published
+		T data;
+	};
+
+	vector<Cell> cells;
+	size_t mask;
+	alignas(64) atomic<size_t> enqueuePos; // Kept on separate cache lines so
+	alignas(64) atomic<size_t> dequeuePos; // producers and consumers don't false-share
+
+public:
+	MpmcRing(size_t capacity) : cells(capacity), mask(capacity - 1), enqueuePos(0), dequeuePos(0)
+	{
+		for (size_t i = 0; i < capacity; i++)
+		{
+			cells[i].sequence.store(i, memory_order_relaxed);
+		}
+	}
+
+	MpmcRing(const MpmcRing &) = delete;
+	MpmcRing &operator=(const MpmcRing &) = delete;
+
+	size_t capacity() const { return cells.size(); }
+
+	// Approximate while other threads are running
+	size_t size() const
+	{
+		size_t head = dequeuePos.load(memory_order_relaxed);
+		size_t tail = enqueuePos.load(memory_order_relaxed);
+		return tail > head ? tail - head : 0;
+	}
+
+	// False if the ring is full
+	bool tryEnqueue(const T &value)
+	{
+		size_t pos = enqueuePos.load(memory_order_relaxed);
+		for (;;)
+		{
+			Cell &cell = cells[pos & mask];
+			size_t seq = cell.sequence.load(memory_order_acquire);
+			intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+			if (diff == 0)
+			{
+				if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed))
+				{
+					cell.data = value;
+					cell.sequence.store(pos + 1, memory_order_release);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false; // Cell still holds an unconsumed value from one lap ago
+			}
+			else
+			{
+				pos = enqueuePos.load(memory_order_relaxed); // Another producer took it
+			}
+		}
+	}
+
+	// Move up to maxCount values into out; returns how many were taken
+	size_t tryDequeueBulk(T *out, size_t maxCount)
+	{
+		size_t pos = dequeuePos.load(memory_order_relaxed);
+		for (;;)
+		{
+			// Count the published cells in a row starting at pos
+			size_t ready = 0;
+			intptr_t diff = 0;
+			while (ready < maxCount)
+			{
+				size_t seq = cells[(pos + ready) & mask].sequence.load(memory_order_acquire);
+				diff = (intptr_t)seq - (intptr_t)(pos + ready + 1);
+				if (diff != 0)
+					break;
+				ready++;
+			}
+
+			if (ready == 0)
+			{
+				if (diff < 0)
+					return 0; // Empty
+				pos = dequeuePos.load(memory_order_relaxed); // Another consumer took it
+				continue;
+			}
+
+			if (dequeuePos.compare_exchange_weak(pos, pos + ready, memory_order_relaxed))
+			{
+				for (size_t i = 0; i < ready; i++)
+				{
+					Cell &cell = cells[(pos + i) & mask];
+					out[i] = cell.data;
+					cell.sequence.store(pos + i + mask + 1, memory_order_release);
+				}
+				return ready;
+			}
+		}
+	}
+
+	bool tryDequeue(T &value) { return tryDequeueBulk(&value, 1) == 1; }
+};
+
+// 18. Sales Journal (durable append-only log of sales and their undos)
+// Fixed-size binary records, each with a checksum so a torn final write is
+// detected and dropped on the next start. Undo never rewrites history: it
+// appends a compensating record. Records are buffered and written with one
+// fwrite + flush + _commit per commit; inside a group (beginGroup/endGroup)
+// every record shares a single commit.
+const int SALES_JOURNAL_SALE = 1; // A sale was recorded
+const int SALES_JOURNAL_UNDO = 2; // A sale was undone (compensating record)
+const int SALES_JOURNAL_REDO = 3; // An undone sale was redone
+const int SALES_JOURNAL_IMPORT = 4; // A historical order carried over from the text order log
+
+const int SALES_JOURNAL_NAME_SIZE = 16;	 // Model/color name bytes per record (NUL-terminated)
+
+struct SalesJournalRecord
+{
+	int type;							 // SALES_JOURNAL_SALE, _UNDO, _REDO or _IMPORT
+	int saleID;							 // Sale the record refers to
+	int customerID;						 // Buyer
+	int carID;							 // Car sold (or returned to stock on undo)
+	double amount;						 // Sale amount
+	Timestamp time;						 // When the sale was made
+	char model[SALES_JOURNAL_NAME_SIZE]; // Model name (names, not interned IDs, survive restarts)
+	char color[SALES_JOURNAL_NAME_SIZE]; // Color name
+	unsigned int check;					 // FNV-1a of every field above
+	unsigned int unused;
+
+	SalesJournalRecord() : type(0), saleID(0), customerID(0), carID(0), amount(0.0), time(0), check(0), unused(0)
+	{
+		model[0] = color[0] = '\0';
+	}
+	SalesJournalRecord(int t, const SaleTransaction &sale)
+		: type(t), saleID(sale.saleID), customerID(sale.customerID), carID(sale.carID),
+		  amount(sale.amount), time(sale.saleTime), check(0), unused(0)
+	{
+		copyName(model, nameDictionary.nameOf(sale.modelID));
+		copyName(color, nameDictionary.nameOf(sale.colorID));
+		check = checksum();
+	}
+
+	static void copyName(char *field, const string &name)
+	{
+		memset(field, 0, SALES_JOURNAL_NAME_SIZE);
+		strncpy(field, name.c_str(), SALES_JOURNAL_NAME_SIZE - 1);
+	}
+
+	unsigned int checksum() const
+	{
+		const unsigned char *bytes = (const unsigned char *)this;
+		unsigned int hash = 2166136261u;
+		for (size_t i = 0; i < offsetof(SalesJournalRecord, check); i++)
+		{
+			hash = (hash ^ bytes[i]) * 16777619u;
+		}
+		return hash;
+	}
+
+	bool valid() const
+	{
+		return type >= SALES_JOURNAL_SALE && type <= SALES_JOURNAL_IMPORT && check == checksum();
+	}
+};
+
+class SalesJournal
+{
+private:
+	FILE *file;							// Open for appending, or nullptr before open()
+	string path;						// File given to open(), reread by salesInEffect()
+	vector<SalesJournalRecord> pending; // Appended but not yet committed
+	int groupDepth;						// Open beginGroup() scopes
+	size_t recordCount;					// Records on disk, including replayed ones
+	size_t commitCount;					// Flush + sync calls issued
+
+public:
+	SalesJournal() : file(nullptr), groupDepth(0), recordCount(0), commitCount(0) {}
+	~SalesJournal() { close(); }
+
+	SalesJournal(const SalesJournal &) = delete;
+	SalesJournal &operator=(const SalesJournal &) = delete;
+
+	// Replay every valid record through apply(record) in order, then open the
+	// file for appending. A torn or corrupt tail is cut off first.
+	template <typename ApplyFn>
+	size_t open(const string &path, ApplyFn apply)
+	{
+		close();
+		this->path = path;
+		vector<SalesJournalRecord> chunk(4096);
+		size_t replayed = 0;
+		bool torn = false;
+		FILE *in = fopen(path.c_str(), "rb");
+		if (in != nullptr)
+		{
+			size_t got;
+			while (!torn && (got = fread(chunk.data(), sizeof(SalesJournalRecord), chunk.size(), in)) > 0)
+			{
+				for (size_t i = 0; i < got && !torn; i++)
+				{
+					if (chunk[i].valid())
+					{
+						apply(chunk[i]);
+						replayed++;
+					}
+					else
+					{
+						torn = true;
+					}
+				}
+			}
+			// A partial trailing record also counts as torn
+			torn = torn || (ftell(in) != (long)(replayed * sizeof(SalesJournalRecord)));
+			fclose(in);
+		}
+
+		if (torn)
+		{
+			// Cut the file back to the good prefix in place so new records are
+			// not appended after garbage; the good records are never rewritten,
+			// so a crash here leaves at worst the same torn tail behind
+			FILE *out = fopen(path.c_str(), "r+b");
+			if (out != nullptr)
+			{
+				_chsize_s(_fileno(out), (long long)(replayed * sizeof(SalesJournalRecord)));
+				_commit(_fileno(out));
+				fclose(out);
+			}
+		}
+
+		file = fopen(path.c_str(), "ab");
+		recordCount = replayed;
+		return replayed;
+	}
+
+	bool isOpen() const { return file != nullptr; }
+
+	void append(const SalesJournalRecord &record)
+	{
+		if (file == nullptr)
+		{
+			return;
+		}
+		pending.push_back(record);
+		if (groupDepth == 0)
+		{
+			commit();
+		}
+	}
+
+	void beginGroup() { groupDepth++; }
+
+	void endGroup()
+	{
+		if (groupDepth > 0 && --groupDepth == 0)
+		{
+			commit();
+		}
+	}
+
+	// Write every pending record with one write and one sync
+	void commit()
+	{
+		if (file == nullptr || pending.empty())
+		{
+			return;
+		}
+		fwrite(pending.data(), sizeof(SalesJournalRecord), pending.size(), file);
+		fflush(file);
+		_commit(_fileno(file));
+		recordCount += pending.size();
+		commitCount++;
+		pending.clear();
+	}
+
+	void close()
+	{
+		if (file != nullptr)
+		{
+			commit();
+			fclose(file);
+			file = nullptr;
+		}
+	}
+
+	size_t records() const { return recordCount; }
+	size_t commits() const { return commitCount; }
+
+	// Sale and import records not undone, in sale ID order, read back from
+	// the committed file; this is the order log
+	vector<SalesJournalRecord> salesInEffect() const
+	{
+		map<int, SalesJournalRecord> inEffect;
+		map<int, SalesJournalRecord> undone;
+		SalesJournalRecord record;
+		FILE *in = path.empty() ? nullptr : fopen(path.c_str(), "rb");
+		while (in != nullptr && fread(&record, sizeof(record), 1, in) == 1 && record.valid())
+		{
+			map<int, SalesJournalRecord> &from = (record.type == SALES_JOURNAL_REDO) ? undone : inEffect;
+			map<int, SalesJournalRecord> &to = (record.type == SALES_JOURNAL_UNDO) ? undone : inEffect;
+			if (record.type == SALES_JOURNAL_SALE || record.type == SALES_JOURNAL_IMPORT)
+			{
+				inEffect[record.saleID] = record;
+			}
+			else if (from.count(record.saleID) != 0)
+			{
+				to[record.saleID] = from[record.saleID];
+				from.erase(record.saleID);
+			}
+		}
+		if (in != nullptr)
+		{
+			fclose(in);
+		}
+
+		vector<SalesJournalRecord> sales;
+		sales.reserve(inEffect.size());
+		for (const auto &entry : inEffect)
+		{
+			sales.push_back(entry.second);
+		}
+		return sales;
+	}
+};
+
+// 19. Bounded Sales Undo/Redo History (ring buffer ordered by sale ID)
+// Only the newest SALES_HISTORY_CAPACITY sales are kept; older ones fall off
+// the ring and can no longer be undone. Undo marks a sale in place instead of
+// removing it, so any sale in the ring can be undone by ID (binary search,
+// since sale IDs only grow) and redone later. activeTop is the end of the
+// newest sale still in effect, so repeated "undo last" never rescans entries.
+const size_t SALES_HISTORY_CAPACITY = 1024;
+
+class SalesHistory
+{
+private:
+	vector<SaleTransaction> ring;  // Circular storage, oldest sale at start
+	vector<unsigned char> undone;  // Per slot: 1 if that sale is currently undone
+	size_t start;				   // Slot of the oldest sale
+	size_t count;				   // Sales in the ring (in effect or undone)
+	size_t activeTop;			   // Entries up to and including the newest sale in effect
+	size_t activeCount;			   // Sales in effect
+	vector<int> redoStack;		   // Undone sale IDs, most recent last
+
+	size_t slot(size_t i) const { return (start + i) % ring.size(); }
+
+	// Position (0 = oldest) of a sale ID, or count if it is not in the ring
+	size_t find(int saleID) const
+	{
+		size_t lo = 0, hi = count;
+		while (lo < hi)
+		{
+			size_t mid = (lo + hi) / 2;
+			if (ring[slot(mid)].saleID < saleID)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo < count && ring[slot(lo)].saleID == saleID ? lo : count;
+	}
+
+	void markUndone(size_t i)
+	{
+		undone[slot(i)] = 1;
+		activeCount--;
+		redoStack.push_back(ring[slot(i)].saleID);
+		while (activeTop > 0 && undone[slot(activeTop - 1)])
+		{
+			activeTop--;
+		}
+	}
+
+public:
+	SalesHistory(size_t capacity)
+		: ring(capacity, SaleTransaction(0, 0, 0, 0.0, 0)), undone(capacity, 0),
+		  start(0), count(0), activeTop(0), activeCount(0) {}
+
+	// Record a new sale; this ends any chance to redo earlier undos
+	void push(const SaleTransaction &sale)
+	{
+		redoStack.clear();
+		count = activeTop; // Undone sales after the newest active one are gone for good
+		if (count == ring.size())
+		{
+			if (!undone[slot(0)])
+				activeCount--;
+			start = slot(1);
+			count--;
+			activeTop--;
+		}
+		ring[slot(count)] = sale;
+		undone[slot(count)] = 0;
+		count++;
+		activeTop = count;
+		activeCount++;
+	}
+
+	bool undoLast(SaleTransaction &sale)
+	{
+		if (activeTop == 0)
+		{
+			return false;
+		}
+		sale = ring[slot(activeTop - 1)];
+		markUndone(activeTop - 1);
+		return true;
+	}
+
+	bool undoByID(int saleID, SaleTransaction &sale)
+	{
+		size_t i = find(saleID);
+		if (i == count || undone[slot(i)])
+		{
+			return false;
+		}
+		sale = ring[slot(i)];
+		markUndone(i);
+		return true;
+	}
+
+	// Put the most recently undone sale back in effect
+	bool redoLast(SaleTransaction &sale)
+	{
+		while (!redoStack.empty())
+		{
+			size_t i = find(redoStack.back());
+			redoStack.pop_back();
+			if (i < count && undone[slot(i)])
+			{
+				undone[slot(i)] = 0;
+				activeCount++;
+				activeTop = max(activeTop, i + 1);
+				sale = ring[slot(i)];
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Visit the sales in effect, oldest first
+	template <typename Visitor>
+	void forEachActive(Visitor visit) const
+	{
+		for (size_t i = 0; i < activeTop; i++)
+		{
+			if (!undone[slot(i)])
+				visit(ring[slot(i)]);
+		}
+	}
+
+	size_t size() const { return activeCount; }
+	size_t redoable() const { return redoStack.size(); }
+	size_t capacity() const { return ring.size(); }
+};
+
+// 20. Sales Rollups (materialized count / revenue / min / max per group)
+// Every sale and undo adjusts its model, color, day and month groups in place.
+// Count and revenue are O(1); min and max come from a small per-group price
+// histogram so they stay exact when a sale is undone (O(log p) for p distinct
+// prices in the group, a handful at most for one model).
+struct SalesAggregate
+{
+	int count;				 // Sales in effect
+	double revenue;			 // Sum of their amounts
+	map<double, int> prices; // Amount -> number of sales at that amount
+
+	SalesAggregate() : count(0), revenue(0.0) {}
+
+	void add(double amount)
+	{
+		count++;
+		revenue += amount;
+		prices[amount]++;
+	}
+
+	void remove(double amount)
+	{
+		count--;
+		revenue -= amount;
+		auto it = prices.find(amount);
+		if (it != prices.end() && --it->second == 0)
+			prices.erase(it);
+	}
+
+	double minPrice() const { return prices.empty() ? 0.0 : prices.begin()->first; }
+	double maxPrice() const { return prices.empty() ? 0.0 : prices.rbegin()->first; }
+};
+
+class SalesRollups
+{
+private:
+	unordered_map<int, SalesAggregate> byModel; // modelID -> aggregate
+	unordered_map<int, SalesAggregate> byColor; // colorID -> aggregate
+	map<int, SalesAggregate> byDay;				// yyyymmdd -> aggregate (in date order)
+	map<int, SalesAggregate> byMonth;			// yyyymm -> aggregate (in date order)
+	SalesAggregate total;
+
+	static void adjust(SalesAggregate &group, double amount, bool adding)
+	{
+		if (adding)
+			group.add(amount);
+		else
+			group.remove(amount);
+	}
+
+	template <typename GroupMap>
+	static void adjustGroup(GroupMap &groups, int key, double amount, bool adding)
+	{
+		SalesAggregate &group = groups[key];
+		adjust(group, amount, adding);
+		if (group.count == 0)
+			groups.erase(key);
+	}
+
+	void apply(const SaleTransaction &sale, bool adding)
+	{
+		time_t raw = (time_t)sale.saleTime;
+		auto tm = *localtime(&raw);
+		int month = (tm.tm_year + 1900) * 100 + tm.tm_mon + 1;
+		adjustGroup(byModel, sale.modelID, sale.amount, adding);
+		adjustGroup(byColor, sale.colorID, sale.amount, adding);
+		adjustGroup(byDay, month * 100 + tm.tm_mday, sale.amount, adding);
+		adjustGroup(byMonth, month, sale.amount, adding);
+		adjust(total, sale.amount, adding);
+	}
+
+	static const SalesAggregate *lookup(const unordered_map<int, SalesAggregate> &groups, int key)
+	{
+		auto it = groups.find(key);
+		return it == groups.end() ? nullptr : &it->second;
+	}
+
+	static const SalesAggregate *lookup(const map<int, SalesAggregate> &groups, int key)
+	{
+		auto it = groups.find(key);
+		return it == groups.end() ? nullptr : &it->second;
+	}
+
+public:
+	void add(const SaleTransaction &sale) { apply(sale, true); }
+	void remove(const SaleTransaction &sale) { apply(sale, false); }
+
+	// nullptr when the group has no sales in effect
+	const SalesAggregate *model(int modelID) const { return lookup(byModel, modelID); }
+	const SalesAggregate *color(int colorID) const { return lookup(byColor, colorID); }
+	const SalesAggregate *day(int yyyymmdd) const { return lookup(byDay, yyyymmdd); }
+	const SalesAggregate *month(int yyyymm) const { return lookup(byMonth, yyyymm); }
+	const SalesAggregate &overall() const { return total; }
+
+	const unordered_map<int, SalesAggregate> &models() const { return byModel; }
+	const unordered_map<int, SalesAggregate> &colors() const { return byColor; }
+	const map<int, SalesAggregate> &days() const { return byDay; }
+	const map<int, SalesAggregate> &months() const { return byMonth; }
+};
+
+// 21. Workflow Graph (departments with integer IDs and CSR adjacency)
+// Department names are mapped to dense IDs once; edges are packed into one
+// array grouped by source (compressed sparse row), so the neighbours of a
+// department are the contiguous slice targets[offsets[d] .. offsets[d + 1]).
+// Traversals work on IDs only and never touch a string.
+class WorkflowGraph
+{
+private:
+	vector<string> names;				   // Department ID -> name
+	unordered_map<string, int> idByName;   // Department name -> ID
+	vector<WorkflowEdge> edges;			   // Edge list the CSR arrays are built from
+	vector<int> offsets;				   // Department ID -> first edge slot (size + 1 entries)
+	vector<int> targets;				   // Edge slot -> destination department
+	vector<int> weights;				   // Edge slot -> hand-off cost
+
+	// Counting sort of the edge list by source department
+	void build()
+	{
+		int n = size();
+		offsets.assign(n + 1, 0);
+		for (const WorkflowEdge &edge : edges)
+		{
+			offsets[edge.from + 1]++;
+		}
+		for (int d = 0; d < n; d++)
+		{
+			offsets[d + 1] += offsets[d];
+		}
+		targets.assign(edges.size(), 0);
+		weights.assign(edges.size(), 0);
+		vector<int> next(offsets.begin(), offsets.end() - 1);
+		for (const WorkflowEdge &edge : edges)
+		{
+			int slot = next[edge.from]++;
+			targets[slot] = edge.to;
+			weights[slot] = edge.weight;
+		}
+	}
+
+public:
+	WorkflowGraph() : offsets(1, 0) {}
+
+	int size() const { return (int)names.size(); }
+	int edgeCount() const { return (int)targets.size(); }
+	const string &nameOf(int dept) const { return names[dept]; }
+
+	// ID of a department, or -1 if there is none by that name
+	int idOf(const string &name) const
+	{
+		auto it = idByName.find(name);
+		return it == idByName.end() ? -1 : it->second;
+	}
+
+	int addDepartment(const string &name)
+	{
+		int id = idOf(name);
+		if (id != -1)
+		{
+			return id;
+		}
+		id = (int)names.size();
+		names.push_back(name);
+		idByName[name] = id;
+		offsets.push_back(offsets.back());
+		return id;
+	}
+
+	void addEdge(const string &from, const string &to, int weight = 1)
+	{
+		int f = addDepartment(from), t = addDepartment(to);
+		edges.push_back(WorkflowEdge(f, t, weight));
+		build();
+	}
+
+	void clear()
+	{
+		names.clear();
+		idByName.clear();
+		edges.clear();
+		offsets.assign(1, 0);
+		targets.clear();
+		weights.clear();
+	}
+
+	// Load "From To [Weight]" lines; a lone name declares a department and
+	// '#' starts a comment. Returns false (graph untouched) if the file is missing.
+	bool loadFromFile(const string &path)
+	{
+		ifstream file(path);
+		if (!file)
+		{
+			return false;
+		}
+
+		clear();
+		string line;
+		while (getline(file, line))
+		{
+			size_t hash = line.find('#');
+			if (hash != string::npos)
+			{
+				line.erase(hash);
+			}
+			istringstream fields(line);
+			string from, to;
+			int weight = 1;
+			if (!(fields >> from))
+			{
+				continue;
+			}
+			int f = addDepartment(from);
+			if (fields >> to)
+			{
+				fields >> weight;
+				edges.push_back(WorkflowEdge(f, addDepartment(to), max(weight, 0)));
+			}
+		}
+		build();
+		return true;
+	}
+
+	// Neighbour slice of a department: [begin, end) into targets()/weights()
+	int edgesBegin(int dept) const { return offsets[dept]; }
+	int edgesEnd(int dept) const { return offsets[dept + 1]; }
+	int target(int slot) const { return targets[slot]; }
+	int weight(int slot) const { return weights[slot]; }
+
+	// Preferred next department after this one: the cheapest outgoing edge
+	// (the first listed on a tie), or -1 if the department has none
+	int handoff(int dept) const
+	{
+		int best = -1;
+		for (int slot = offsets[dept]; slot < offsets[dept + 1]; slot++)
+		{
+			if (best == -1 || weights[slot] < weights[best])
+				best = slot;
+		}
+		return best == -1 ? -1 : targets[best];
+	}
+
+	bool hasEdge(int from, int to) const
+	{
+		if (from < 0 || from >= size())
+		{
+			return false;
+		}
+		for (int slot = offsets[from]; slot < offsets[from + 1]; slot++)
+		{
+			if (targets[slot] == to)
+				return true;
+		}
+		return false;
+	}
+
+	// Departments reachable from start, in breadth-first order
+	vector<int> bfs(int start) const
+	{
+		vector<int> order;
+		if (start < 0 || start >= size())
+		{
+			return order;
+		}
+		vector<unsigned char> visited(size(), 0);
+		visited[start] = 1;
+		order.push_back(start);
+		for (size_t head = 0; head < order.size(); head++)
+		{
+			int current = order[head];
+			for (int slot = offsets[current]; slot < offsets[current + 1]; slot++)
+			{
+				if (!visited[targets[slot]])
+				{
+					visited[targets[slot]] = 1;
+					order.push_back(targets[slot]);
+				}
+			}
+		}
+		return order;
+	}
+
+	// Cheapest path from one department to another (Dijkstra on hand-off
+	// weights); empty if unreachable. totalCost receives the path cost.
+	vector<int> shortestPath(int from, int to, int &totalCost) const
+	{
+		vector<int> path;
+		totalCost = -1;
+		int n = size();
+		if (from < 0 || from >= n || to < 0 || to >= n)
+		{
+			return path;
+		}
+
+		const int unreached = numeric_limits<int>::max();
+		vector<int> dist(n, unreached), parent(n, -1);
+		typedef pair<int, int> Entry; // (distance, department)
+		priority_queue<Entry, vector<Entry>, greater<Entry>> frontier;
+		dist[from] = 0;
+		frontier.push(Entry(0, from));
+		while (!frontier.empty())
+		{
+			Entry top = frontier.top();
+			frontier.pop();
+			if (top.first > dist[top.second])
+				continue;
+			if (top.second == to)
+				break;
+			for (int slot = offsets[top.second]; slot < offsets[top.second + 1]; slot++)
+			{
+				int candidate = top.first + weights[slot];
+				if (candidate < dist[targets[slot]])
+				{
+					dist[targets[slot]] = candidate;
+					parent[targets[slot]] = top.second;
+					frontier.push(Entry(candidate, targets[slot]));
+				}
+			}
+		}
+
+		if (dist[to] == unreached)
+		{
+			return path;
+		}
+		for (int d = to; d != -1; d = parent[d])
+		{
+			path.push_back(d);
+		}
+		reverse(path.begin(), path.end());
+		totalCost = dist[to];
+		return path;
+	}
+
+	// One directed cycle as a department list (first == last), or empty if the
+	// workflow is acyclic. Iterative DFS with white/grey/black colouring.
+	vector<int> findCycle() const
+	{
+		int n = size();
+		vector<unsigned char> colour(n, 0); // 0 unvisited, 1 on stack, 2 done
+		vector<int> parent(n, -1), nextSlot(n, 0);
+		vector<int> stackDepts;
+		for (int root = 0; root < n; root++)
+		{
+			if (colour[root] != 0)
+				continue;
+			colour[root] = 1;
+			nextSlot[root] = offsets[root];
+			stackDepts.push_back(root);
+			while (!stackDepts.empty())
+			{
+				int current = stackDepts.back();
+				if (nextSlot[current] == offsets[current + 1])
+				{
+					colour[current] = 2;
+					stackDepts.pop_back();
+					continue;
+				}
+				int child = targets[nextSlot[current]++];
+				if (colour[child] == 1)
+				{
+					// Back edge: walk parents from current up to child
+					vector<int> cycle(1, child);
+					for (int d = current; d != child; d = parent[d])
+					{
+						cycle.push_back(d);
+					}
+					cycle.push_back(child);
+					reverse(cycle.begin(), cycle.end());
+					return cycle;
+				}
+				if (colour[child] == 0)
+				{
+					colour[child] = 1;
+					parent[child] = current;
+					nextSlot[child] = offsets[child];
+					stackDepts.push_back(child);
+				}
+			}
+		}
+		return vector<int>();
+	}
+};
+
+// 22. Deal Workflow Tracker (each sale is a deal token moving through the workflow)
+// Every department has a FIFO work queue. A deal waits in a queue, is started
+// (wait time recorded), finished (service time recorded) and handed on.
+// Branch rule: the operator finishing the deal may name any department the
+// current one has an edge to; otherwise the deal takes the preferred edge
+// (WorkflowGraph::handoff, the cheapest). A deal closes when there is no next
+// department or the next one is a department it has already been through
+// (including the one it entered at), so a cycle anywhere in the workflow
+// cannot keep it moving forever. Per-department counters plus an hour-of-day
+// wait histogram show where deals pile up.
+const int DEAL_WAITING = 0;
+const int DEAL_IN_PROGRESS = 1;
+
+struct Deal
+{
+	int dealID;			 // Same as the sale ID
+	int dept;			 // Department currently holding the deal
+	int entryDept;		 // Department the deal entered the workflow at
+	int state;			 // DEAL_WAITING or DEAL_IN_PROGRESS
+	Timestamp openedAt;	 // When the sale was recorded
+	Timestamp enteredAt; // When the deal joined its current queue
+	Timestamp startedAt; // When the current department started it
+	vector<int> visited; // Departments the deal has been through, in order
+
+	Deal() : dealID(0), dept(0), entryDept(0), state(DEAL_WAITING), openedAt(0), enteredAt(0), startedAt(0) {}
+};
+
+struct DepartmentStats
+{
+	int arrivals;				 // Deals that joined the queue
+	int started;				 // Deals taken off the queue
+	int completed;				 // Deals handed on or closed
+	int queueLength;			 // Deals waiting now
+	int maxQueueLength;			 // Longest the queue has been
+	long long totalWait;		 // Seconds waited by started deals
+	long long totalService;		 // Seconds spent on completed deals
+	long long hourWait[24];		 // Seconds waited, by hour of day the deal was started
+	int hourStarted[24];		 // Deals started, by hour of day
+	Timestamp firstArrival;		 // For throughput
+	Timestamp lastCompletion;	 // For throughput
+
+	DepartmentStats() : arrivals(0), started(0), completed(0), queueLength(0), maxQueueLength(0),
+						totalWait(0), totalService(0), firstArrival(0), lastCompletion(0)
+	{
+		for (int h = 0; h < 24; h++)
+		{
+			hourWait[h] = 0;
+			hourStarted[h] = 0;
+		}
+	}
+
+	double averageWait() const { return started ? (double)totalWait / started : 0.0; }
+	double averageService() const { return completed ? (double)totalService / completed : 0.0; }
+	double averageWaitAt(int hour) const { return hourStarted[hour] ? (double)hourWait[hour] / hourStarted[hour] : 0.0; }
+
+	// Completed deals per hour between the first arrival and the last completion
+	double throughputPerHour() const
+	{
+		Timestamp span = lastCompletion - firstArrival;
+		return completed && span > 0 ? completed * 3600.0 / span : 0.0;
+	}
+};
+
+class DealTracker
+{
+private:
+	unordered_map<int, Deal> deals;	  // Open deals by ID
+	vector<deque<int>> waiting;		  // Department -> queued deal IDs (cancelled ones skipped lazily)
+	vector<deque<int>> working;		  // Department -> deals in progress, oldest first
+	vector<DepartmentStats> stats;	  // Department -> counters
+	unordered_set<int> cancelled;	  // Deals dropped by an undo, reopened by a redo
+	int closedCount;				  // Deals that finished the workflow
+	long long totalCycleTime;		  // Seconds from sale to close, summed
+
+	static int hourOf(Timestamp t)
+	{
+		time_t raw = (time_t)t;
+		return localtime(&raw)->tm_hour;
+	}
+
+	void enqueue(Deal &deal, int dept, Timestamp now)
+	{
+		deal.dept = dept;
+		deal.state = DEAL_WAITING;
+		deal.enteredAt = now;
+		deal.visited.push_back(dept);
+		waiting[dept].push_back(deal.dealID);
+		DepartmentStats &st = stats[dept];
+		if (st.arrivals++ == 0)
+			st.firstArrival = now;
+		st.maxQueueLength = max(st.maxQueueLength, ++st.queueLength);
+	}
+
+public:
+	DealTracker() : closedCount(0), totalCycleTime(0) {}
+
+	// Start over for a workflow with departmentCount departments
+	void reset(int departmentCount)
+	{
+		deals.clear();
+		waiting.assign(departmentCount, deque<int>());
+		working.assign(departmentCount, deque<int>());
+		stats.assign(departmentCount, DepartmentStats());
+		cancelled.clear();
+		closedCount = 0;
+		totalCycleTime = 0;
+	}
+
+	bool open(int dealID, int entryDept, Timestamp now)
+	{
+		if (entryDept < 0 || entryDept >= (int)stats.size() || deals.count(dealID))
+		{
+			return false;
+		}
+		Deal &deal = deals[dealID];
+		deal.dealID = dealID;
+		deal.entryDept = entryDept;
+		deal.openedAt = now;
+		enqueue(deal, entryDept, now);
+		return true;
+	}
+
+	// Take the oldest waiting deal of a department; false if none is waiting
+	bool startNext(int dept, Timestamp now, int &dealID)
+	{
+		deque<int> &queue = waiting[dept];
+		while (!queue.empty())
+		{
+			int id = queue.front();
+			queue.pop_front();
+			auto it = deals.find(id);
+			if (it == deals.end() || it->second.state != DEAL_WAITING || it->second.dept != dept)
+			{
+				continue; // Stale entry; cancel() removes its own, so this is only a safeguard
+			}
+			Deal &deal = it->second;
+			deal.state = DEAL_IN_PROGRESS;
+			deal.startedAt = now;
+			working[dept].push_back(id);
+
+			DepartmentStats &st = stats[dept];
+			long long waited = now - deal.enteredAt;
+			int hour = hourOf(now);
+			st.queueLength--;
+			st.started++;
+			st.totalWait += waited;
+			st.hourWait[hour] += waited;
+			st.hourStarted[hour]++;
+			dealID = id;
+			return true;
+		}
+		return false;
+	}
+
+	// Finish a deal in progress and hand it on (or close it); false if not in progress
+	// nextDept is the operator's choice of department to hand the deal to, or
+	// -1 for the preferred edge; false if the deal is not in progress or the
+	// choice is not an edge out of the deal's department
+	bool finish(int dealID, const WorkflowGraph &graph, Timestamp now, int nextDept = -1)
+	{
+		auto it = deals.find(dealID);
+		if (it == deals.end() || it->second.state != DEAL_IN_PROGRESS)
+		{
+			return false;
+		}
+		Deal &deal = it->second;
+		int dept = deal.dept;
+		if (nextDept != -1 && !graph.hasEdge(dept, nextDept))
+		{
+			return false;
+		}
+		deque<int> &active = working[dept];
+		active.erase(std::find(active.begin(), active.end(), dealID));
+
+		DepartmentStats &st = stats[dept];
+		st.completed++;
+		st.totalService += now - deal.startedAt;
+		st.lastCompletion = now;
+
+		int next = nextDept != -1 ? nextDept : graph.handoff(dept);
+		if (next == -1 || std::find(deal.visited.begin(), deal.visited.end(), next) != deal.visited.end())
+		{
+			closedCount++;
+			totalCycleTime += now - deal.openedAt;
+			deals.erase(it);
+		}
+		else
+		{
+			enqueue(deal, next, now);
+		}
+		return true;
+	}
+
+	// Oldest deal in progress at a department, or -1
+	int oldestInProgress(int dept) const
+	{
+		return working[dept].empty() ? -1 : working[dept].front();
+	}
+
+	// Drop a deal wherever it is (its sale was undone)
+	bool cancel(int dealID)
+	{
+		auto it = deals.find(dealID);
+		if (it == deals.end())
+		{
+			return false;
+		}
+		Deal &deal = it->second;
+		if (deal.state == DEAL_WAITING)
+		{
+			// Leave no queue entry behind: a reopened deal with this ID must
+			// queue again at the back, not take the old place
+			deque<int> &queue = waiting[deal.dept];
+			queue.erase(std::find(queue.begin(), queue.end(), dealID));
+			stats[deal.dept].queueLength--;
+		}
+		else
+		{
+			deque<int> &active = working[deal.dept];
+			active.erase(std::find(active.begin(), active.end(), dealID));
+		}
+		deals.erase(it);
+		cancelled.insert(dealID);
+		return true;
+	}
+
+	// Put a cancelled deal back at the start of the workflow (its sale was redone)
+	bool reopen(int dealID, int entryDept, Timestamp now)
+	{
+		return cancelled.erase(dealID) && open(dealID, entryDept, now);
+	}
+
+	// Department with the longest average wait (at a given hour of day, or
+	// overall when hour is -1); -1 if nothing has been started yet
+	int bottleneck(int hour = -1) const
+	{
+		int worst = -1;
+		double worstWait = -1.0;
+		for (int dept = 0; dept < (int)stats.size(); dept++)
+		{
+			const DepartmentStats &st = stats[dept];
+			if ((hour < 0 ? st.started : st.hourStarted[hour]) == 0)
+				continue;
+			double wait = hour < 0 ? st.averageWait() : st.averageWaitAt(hour);
+			if (wait > worstWait)
+			{
+				worstWait = wait;
+				worst = dept;
+			}
+		}
+		return worst;
+	}
+
+	// Hour of day with the most deals started across all departments, or -1
+	int peakHour() const
+	{
+		int best = -1, bestCount = 0;
+		for (int h = 0; h < 24; h++)
+		{
+			int count = 0;
+			for (const DepartmentStats &st : stats)
+				count += st.hourStarted[h];
+			if (count > bestCount)
+			{
+				bestCount = count;
+				best = h;
+			}
+		}
+		return best;
+	}
+
+	const DepartmentStats &department(int dept) const { return stats[dept]; }
+	int inProgress(int dept) const { return (int)working[dept].size(); }
+	int openDeals() const { return (int)deals.size(); }
+	int closedDeals() const { return closedCount; }
+	double averageCycleTime() const { return closedCount ? (double)totalCycleTime / closedCount : 0.0; }
+};
+
+// 23. Discrete-Event Workflow Simulator (offline capacity planning)
+// Customers arrive, queue at a department, are served by one of its staff
+// and move on along the workflow, all on a simulated clock. Only arrivals
+// and service completions are events, so a year of showroom traffic is a
+// few hundred thousand heap operations. Sale customers walk the workflow
+// from the entry department along the preferred edges (the route a deal
+// takes when nobody picks a branch) and leave before any department would
+// be visited a second time, so a cycle in the workflow cannot trap them;
+// test drive customers visit the test drive department only. Service times are
+// exponential around a per-department mean. Staff only start work while the
+// showroom is open (a visit running at closing time is finished); whatever
+// is still queued waits for the next morning. Days are taken as 86400 s from
+// the first local midnight, so a DST change shifts hours by one. Nothing here
+// touches the live dealership state.
+const int SIM_SALE = 0;
+const int SIM_TEST_DRIVE = 1;
+const int SIM_WAIT_BUCKETS = 7 * 24 * 60; // One-minute buckets for wait percentiles; the last holds the rest
+
+struct SimulationArrival
+{
+	Timestamp time; // When the customer walks in
+	int kind;		// SIM_SALE or SIM_TEST_DRIVE
+
+	SimulationArrival(Timestamp t = 0, int k = SIM_SALE) : time(t), kind(k) {}
+	bool operator<(const SimulationArrival &other) const { return time < other.time; }
+};
+
+struct SimulationConfig
+{
+	vector<int> staff;				// Department -> staff on duty
+	vector<double> serviceMinutes;	// Department -> mean service time
+	double testDriveMinutes;		// Mean time a test drive takes
+	int testDriveDept;				// Department that runs test drives
+	int entryDept;					// Department sale customers start at
+	int days;						// Days to synthesize
+	double salesPerDay;				// Mean sale customers per day
+	double testDrivesPerDay;		// Mean test drive customers per day
+	int openHour, closeHour;		// Arrivals only come in while open
+	double weekendFactor;			// Traffic multiplier on Saturday and Sunday
+	unsigned seed;					// Same seed, same run
+	vector<SimulationArrival> replay; // When non-empty, used instead of synthetic arrivals
+
+	SimulationConfig() : testDriveMinutes(30.0), testDriveDept(0), entryDept(0), days(365),
+						 salesPerDay(40.0), testDrivesPerDay(60.0), openHour(9), closeHour(21),
+						 weekendFactor(1.5), seed(2024) {}
+};
+
+struct SimulationDeptResult
+{
+	int arrivals;			 // Visits that joined the queue
+	int served;				 // Visits finished
+	double averageWait;		 // Seconds from joining the queue to being served
+	double p95Wait;			 // Seconds, to the minute
+	Timestamp maxWait;		 // Seconds
+	double averageQueue;	 // Time-weighted customers waiting
+	int maxQueue;			 // Most customers waiting at once
+	double utilization;		 // Busy staff time within opening hours / staffed opening hours
+	double overtimeHours;	 // Staff time spent finishing services after closing
+};
+
+struct SimulationResult
+{
+	vector<SimulationDeptResult> departments;
+	int customers;			 // Customers that finished
+	double averageLatency;	 // Seconds from arrival to leaving
+	double p95Latency;		 // Seconds, to the minute
+	Timestamp span;			 // Simulated seconds
+	long long events;		 // Events processed
+	double elapsedMs;		 // Wall time of the run
+};
+
+class WorkflowSimulator
+{
+private:
+	struct Event
+	{
+		Timestamp time;
+		long long order; // Tie-break: first scheduled, first handled
+		int customer;
+		int dept;
+		bool operator>(const Event &other) const { return time != other.time ? time > other.time : order > other.order; }
+	};
+
+	struct DeptState
+	{
+		deque<pair<int, Timestamp>> queue; // (customer, time joined)
+		int busy;
+		long long busySeconds;	   // Service time inside opening hours
+		long long overtimeSeconds; // Service time running past closing
+		long long queueArea; // Integral of queue length over time
+		Timestamp lastChange;
+		bool wakeScheduled; // An opening event is pending for this department
+		int arrivals, served, maxQueue;
+		long long totalWait;
+		Timestamp maxWait;
+		vector<int> waitHistogram;
+	};
+
+	const WorkflowGraph &graph;
+	SimulationConfig config;
+	mt19937 rng;
+	priority_queue<Event, vector<Event>, greater<Event>> events;
+	vector<DeptState> depts;
+	vector<int> customerKind;
+	vector<Timestamp> customerArrival;
+	vector<int> customerHop; // Customer -> index of its current stop in saleRoute
+	vector<int> saleRoute;	 // Departments a sale customer visits, in order
+	vector<int> latencyHistogram;
+	long long totalLatency;
+	Timestamp midnight; // Local midnight of the first simulated day
+	int finished;
+	long long scheduled;
+	long long processed;
+
+	static double percentile(const vector<int> &histogram, int total, double fraction)
+	{
+		long long needed = (long long)(total * fraction + 0.999999), seen = 0;
+		for (size_t bucket = 0; bucket < histogram.size(); bucket++)
+		{
+			seen += histogram[bucket];
+			if (seen >= needed && needed > 0)
+				return bucket * 60.0;
+		}
+		return 0.0;
+	}
+
+	void schedule(Timestamp time, int customer, int dept)
+	{
+		events.push(Event{time, scheduled++, customer, dept});
+	}
+
+	Timestamp serviceTime(int customer, int dept)
+	{
+		double mean = customerKind[customer] == SIM_TEST_DRIVE ? config.testDriveMinutes : config.serviceMinutes[dept];
+		exponential_distribution<double> draw(1.0 / max(mean, 0.01));
+		return (Timestamp)(draw(rng) * 60.0) + 1;
+	}
+
+	bool isOpen(Timestamp now) const
+	{
+		Timestamp second = (now - midnight) % 86400;
+		return second >= config.openHour * 3600 && second < config.closeHour * 3600;
+	}
+
+	// Seconds of [from, to) that fall inside opening hours
+	Timestamp openSecondsBetween(Timestamp from, Timestamp to) const
+	{
+		Timestamp open = 0;
+		for (Timestamp day = from - (from - midnight) % 86400; day < to; day += 86400)
+		{
+			Timestamp first = max(from, day + config.openHour * 3600);
+			Timestamp last = min(to, day + config.closeHour * 3600);
+			open += max<Timestamp>(last - first, 0);
+		}
+		return open;
+	}
+
+	Timestamp nextOpening(Timestamp now) const
+	{
+		Timestamp day = now - (now - midnight) % 86400;
+		Timestamp opening = day + config.openHour * 3600;
+		return opening > now ? opening : opening + 86400;
+	}
+
+	// Staff on duty pick up waiting customers; after hours, come back at opening
+	void startWaiting(int deptID, Timestamp now)
+	{
+		DeptState &dept = depts[deptID];
+		if (dept.queue.empty())
+		{
+			return;
+		}
+		if (!isOpen(now))
+		{
+			if (!dept.wakeScheduled)
+			{
+				dept.wakeScheduled = true;
+				schedule(nextOpening(now), -1, deptID);
+			}
+			return;
+		}
+		touch(dept, now);
+		while (!dept.queue.empty() && dept.busy < config.staff[deptID])
+		{
+			pair<int, Timestamp> next = dept.queue.front();
+			dept.queue.pop_front();
+			serve(deptID, next.first, next.second, now);
+		}
+	}
+
+	void touch(DeptState &dept, Timestamp now)
+	{
+		dept.queueArea += (long long)dept.queue.size() * (now - dept.lastChange);
+		dept.lastChange = now;
+	}
+
+	void serve(int deptID, int customer, Timestamp joined, Timestamp now)
+	{
+		DeptState &dept = depts[deptID];
+		Timestamp waited = now - joined;
+		dept.totalWait += waited;
+		dept.maxWait = max(dept.maxWait, waited);
+		dept.waitHistogram[(size_t)min<Timestamp>(waited / 60, SIM_WAIT_BUCKETS - 1)]++;
+		dept.busy++;
+		Timestamp service = serviceTime(customer, deptID);
+		Timestamp inHours = openSecondsBetween(now, now + service);
+		dept.busySeconds += inHours;
+		dept.overtimeSeconds += service - inHours;
+		schedule(now + service, customer, ~deptID); // ~dept marks a departure
+	}
+
+	void arrive(int customer, int deptID, Timestamp now)
+	{
+		DeptState &dept = depts[deptID];
+		dept.arrivals++;
+		touch(dept, now);
+		dept.queue.push_back(make_pair(customer, now));
+		dept.maxQueue = max(dept.maxQueue, (int)dept.queue.size());
+		startWaiting(deptID, now);
+	}
+
+	void depart(int customer, int deptID, Timestamp now)
+	{
+		DeptState &dept = depts[deptID];
+		dept.busy--;
+		dept.served++;
+		startWaiting(deptID, now);
+
+		if (customerKind[customer] == SIM_SALE && ++customerHop[customer] < (int)saleRoute.size())
+		{
+			schedule(now, customer, saleRoute[customerHop[customer]]);
+			return;
+		}
+		Timestamp latency = now - customerArrival[customer];
+		totalLatency += latency;
+		latencyHistogram[(size_t)min<Timestamp>(latency / 60, SIM_WAIT_BUCKETS - 1)]++;
+		finished++;
+	}
+
+	// Poisson arrivals during opening hours, busier at weekends
+	vector<SimulationArrival> synthesize(Timestamp start)
+	{
+		vector<SimulationArrival> arrivals;
+		int openSeconds = (config.closeHour - config.openHour) * 3600;
+		for (int day = 0; day < config.days; day++)
+		{
+			Timestamp dayStart = start + (Timestamp)day * 86400 + config.openHour * 3600;
+			time_t raw = (time_t)dayStart;
+			int weekday = localtime(&raw)->tm_wday;
+			double factor = (weekday == 0 || weekday == 6) ? config.weekendFactor : 1.0;
+			double rates[2] = {config.salesPerDay * factor, config.testDrivesPerDay * factor};
+			for (int kind = 0; kind < 2; kind++)
+			{
+				int count = poisson_distribution<int>(max(rates[kind], 0.0))(rng);
+				uniform_int_distribution<int> second(0, openSeconds - 1);
+				for (int i = 0; i < count; i++)
+				{
+					arrivals.push_back(SimulationArrival(dayStart + second(rng), kind));
+				}
+			}
+		}
+		sort(arrivals.begin(), arrivals.end());
+		return arrivals;
+	}
+
+public:
+	WorkflowSimulator(const WorkflowGraph &workflow, const SimulationConfig &settings)
+		: graph(workflow), config(settings), rng(settings.seed), totalLatency(0), midnight(0), finished(0), scheduled(0), processed(0)
+	{
+		int n = graph.size();
+		config.staff.resize(n, 1);
+		config.serviceMinutes.resize(n, 30.0);
+	}
+
+	SimulationResult run()
+	{
+		auto clockStart = chrono::steady_clock::now();
+		int n = graph.size();
+		SimulationResult result;
+		result.customers = 0;
+		result.averageLatency = result.p95Latency = 0.0;
+		result.span = 0;
+		result.events = 0;
+		if (n == 0 || config.entryDept < 0 || config.entryDept >= n || config.testDriveDept < 0 || config.testDriveDept >= n)
+		{
+			result.elapsedMs = 0.0;
+			return result;
+		}
+
+		// Synthetic calendar starts tomorrow; a replay starts on its first day
+		config.openHour = min(max(config.openHour, 0), 23);
+		config.closeHour = min(max(config.closeHour, config.openHour + 1), 24);
+		time_t raw = (time_t)(currentTimestamp() + 86400);
+		vector<SimulationArrival> arrivals = config.replay;
+		sort(arrivals.begin(), arrivals.end());
+		if (!arrivals.empty())
+			raw = (time_t)arrivals.front().time;
+		tm day = *localtime(&raw);
+		day.tm_hour = day.tm_min = day.tm_sec = 0;
+		day.tm_isdst = -1;
+		midnight = (Timestamp)mktime(&day);
+		if (config.replay.empty())
+			arrivals = synthesize(midnight);
+		Timestamp start = arrivals.empty() ? midnight : arrivals.front().time;
+
+		DeptState blank = {deque<pair<int, Timestamp>>(), 0, 0, 0, 0, start, false, 0, 0, 0, 0, 0, vector<int>(SIM_WAIT_BUCKETS, 0)};
+		depts.assign(n, blank);
+		latencyHistogram.assign(SIM_WAIT_BUCKETS, 0);
+		saleRoute.clear();
+		vector<bool> onRoute(n, false);
+		for (int dept = config.entryDept; dept != -1 && !onRoute[dept]; dept = graph.handoff(dept))
+		{
+			onRoute[dept] = true;
+			saleRoute.push_back(dept);
+		}
+		customerKind.resize(arrivals.size());
+		customerArrival.resize(arrivals.size());
+		customerHop.assign(arrivals.size(), 0);
+		for (size_t i = 0; i < arrivals.size(); i++)
+		{
+			customerKind[i] = arrivals[i].kind;
+			customerArrival[i] = arrivals[i].time;
+			schedule(arrivals[i].time, (int)i, arrivals[i].kind == SIM_TEST_DRIVE ? config.testDriveDept : config.entryDept);
+		}
+
+		Timestamp now = start;
+		while (!events.empty())
+		{
+			Event event = events.top();
+			events.pop();
+			now = event.time;
+			processed++;
+			if (event.customer < 0)
+			{
+				depts[event.dept].wakeScheduled = false;
+				startWaiting(event.dept, now);
+			}
+			else if (event.dept >= 0)
+				arrive(event.customer, event.dept, now);
+			else
+				depart(event.customer, ~event.dept, now);
+		}
+
+		// Staffed time covers every calendar day touched, including any spill-over
+		Timestamp span = max<Timestamp>(now - start, 1);
+		Timestamp calendarDays = (now - midnight) / 86400 + 1;
+		double staffedSeconds = (double)calendarDays * (config.closeHour - config.openHour) * 3600.0;
+		result.departments.resize(n);
+		for (int d = 0; d < n; d++)
+		{
+			DeptState &dept = depts[d];
+			touch(dept, now);
+			SimulationDeptResult &out = result.departments[d];
+			out.arrivals = dept.arrivals;
+			out.served = dept.served;
+			out.averageWait = dept.served ? (double)dept.totalWait / dept.served : 0.0;
+			out.p95Wait = percentile(dept.waitHistogram, dept.served, 0.95);
+			out.maxWait = dept.maxWait;
+			out.averageQueue = (double)dept.queueArea / span;
+			out.maxQueue = dept.maxQueue;
+			out.utilization = config.staff[d] > 0 ? dept.busySeconds / (config.staff[d] * staffedSeconds) : 0.0;
+			out.overtimeHours = dept.overtimeSeconds / 3600.0;
+		}
+		result.customers = finished;
+		result.averageLatency = finished ? (double)totalLatency / finished : 0.0;
+		result.p95Latency = percentile(latencyHistogram, finished, 0.95);
+		result.span = span;
+		result.events = processed;
+		result.elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - clockStart).count();
+		return result;
+	}
+};
+
+// 24. Recommendation Scoring Policies (composed at compile time)
+// A policy is a struct with a static score() over one car's columns. Terms
+// are scaled with Weighted<Policy, Percent> and added with Combined<...>,
+// so a policy such as
+//     Combined<Weighted<BudgetFitPolicy, 70>, Weighted<PopularityPolicy, 30>>
+// is a single inline expression; scoreRecommendationsWith<Policy> applies it
+// over a block of rows in a branch-free loop the compiler can vectorize.
+// Adding a policy means adding a struct, not editing the scan.
+const int RECOMMENDATION_BUDGET_PERCENT = 70;		  // Default weight of budget fit
+const int RECOMMENDATION_POPULARITY_PERCENT = 30;	  // Default weight of popularity
+const double RECOMMENDATION_POPULARITY_SCALE = 10.0;  // Popularity is rated 0..10
+const double RECOMMENDATION_RECENCY_DAYS = 30.0;	  // Age at which recency counts half
+const size_t RECOMMENDATION_BLOCK = 1024;			  // Rows scored per kernel call
+
+struct ScoringContext
+{
+	double budget; // Customer's budget
+	Timestamp now; // For recency
+
+	ScoringContext(double b, Timestamp t = 0) : budget(b), now(t) {}
+};
+
+// Share of the budget left over: 1 for a free car, 0 at the budget
+struct BudgetFitPolicy
+{
+	static const bool usesTime = false; // Score depends on context.now
+
+	static double score(double price, int, double, Timestamp, const ScoringContext &context)
+	{
+		return (context.budget - price) / context.budget;
+	}
+};
+
+// Popularity rating scaled to 0..1
+struct PopularityPolicy
+{
+	static const bool usesTime = false;
+
+	static double score(double, int popularity, double, Timestamp, const ScoringContext &)
+	{
+		return popularity / RECOMMENDATION_POPULARITY_SCALE;
+	}
+};
+
+// Dealer margin as a share of the price
+struct MarginPolicy
+{
+	static const bool usesTime = false;
+
+	static double score(double price, int, double cost, Timestamp, const ScoringContext &)
+	{
+		return (price - cost) / price;
+	}
+};
+
+// 1 for a car that just arrived, halving by RECOMMENDATION_RECENCY_DAYS
+struct RecencyPolicy
+{
+	static const bool usesTime = true;
+
+	static double score(double, int, double, Timestamp addedAt, const ScoringContext &context)
+	{
+		double ageDays = (double)max<Timestamp>(context.now - addedAt, 0) / 86400.0;
+		return 1.0 / (1.0 + ageDays / RECOMMENDATION_RECENCY_DAYS);
+	}
+};
+
+template <typename Policy, int Percent>
+struct Weighted
+{
+	static const bool usesTime = Policy::usesTime;
+
+	static double score(double price, int popularity, double cost, Timestamp addedAt, const ScoringContext &context)
+	{
+		return Policy::score(price, popularity, cost, addedAt, context) * (Percent / 100.0);
+	}
+};
+
+template <typename... Policies>
+struct Combined;
+
+template <typename First, typename... Rest>
+struct Combined<First, Rest...>
+{
+	static const bool usesTime = First::usesTime || Combined<Rest...>::usesTime;
+
+	static double score(double price, int popularity, double cost, Timestamp addedAt, const ScoringContext &context)
+	{
+		return First::score(price, popularity, cost, addedAt, context) +
+			   Combined<Rest...>::score(price, popularity, cost, addedAt, context);
+	}
+};
+
+template <>
+struct Combined<>
+{
+	static const bool usesTime = false;
+
+	static double score(double, int, double, Timestamp, const ScoringContext &) { return 0.0; }
+};
+
+// The showroom's standard ranking, and the ones offered from the menu
+typedef Combined<Weighted<BudgetFitPolicy, RECOMMENDATION_BUDGET_PERCENT>,
+				 Weighted<PopularityPolicy, RECOMMENDATION_POPULARITY_PERCENT>>
+	BalancedScoringPolicy;
+typedef Combined<Weighted<MarginPolicy, 60>, Weighted<BudgetFitPolicy, 40>> MarginScoringPolicy;
+typedef Combined<Weighted<RecencyPolicy, 50>, Weighted<PopularityPolicy, 30>, Weighted<BudgetFitPolicy, 20>> NewArrivalScoringPolicy;
+
+inline double recommendationScore(double price, int popularity, double budget)
+{
+	return BalancedScoringPolicy::score(price, popularity, 0.0, 0, ScoringContext(budget));
+}
+
+// Scores rows [begin, begin + n) of the inventory; writes the offsets (from
+// begin) and scores of rows that are available, within budget and score at
+// least threshold into rows/scores and returns how many did
+typedef size_t (*RecommendationKernel)(const InventoryStore &inventory, size_t begin, size_t n,
+									   const ScoringContext &context, double threshold, int *rows, double *scores);
+
+template <typename Policy>
+size_t scoreRecommendationsWith(const InventoryStore &inventory, size_t begin, size_t n,
+								const ScoringContext &context, double threshold, int *rows, double *scores)
+{
+	const double *prices = &inventory.prices[begin];
+	const int *popularity = &inventory.popularity[begin];
+	const double *costs = &inventory.costs[begin];
+	const Timestamp *addedAt = &inventory.addedAt[begin];
+	const unsigned char *available = &inventory.available[begin];
+
+	double blockScores[RECOMMENDATION_BLOCK];
+	for (size_t i = 0; i < n; i++) // No branches: vectorizable for any policy
+	{
+		blockScores[i] = Policy::score(prices[i], popularity[i], costs[i], addedAt[i], context);
+	}
+
+	size_t found = 0;
+	for (size_t i = 0; i < n; i++) // Branch-free compaction: always write, advance on a pass
+	{
+		rows[found] = (int)i;
+		scores[found] = blockScores[i];
+		found += (available[i] != 0) & (prices[i] <= context.budget) & (blockScores[i] >= threshold);
+	}
+	return found;
+}
+
+// 25. Batch Recommendation Scoring (SIMD kernels with runtime dispatch)
+// The balanced score is evaluated straight off the packed price,
+// popularity and availability columns, four cars per AVX2 instruction (two
+// with SSE2). A kernel only reports rows that are available, within budget
+// and score at least the caller's threshold (the current k-th best), so
+// almost every row is rejected without leaving vector registers. Each
+// kernel performs the same IEEE operations in the same order as
+// BalancedScoringPolicy, so scores match the scalar path exactly unless the
+// compiler fuses the scalar multiply-add (FMA contraction), which can move a
+// score by one ulp. The best kernel the CPU supports is picked once at
+// first use.
+const double RECOMMENDATION_BUDGET_WEIGHT = RECOMMENDATION_BUDGET_PERCENT / 100.0;
+const double RECOMMENDATION_POPULARITY_WEIGHT = RECOMMENDATION_POPULARITY_PERCENT / 100.0;
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define RECOMMENDATION_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SIMD_TARGET_AVX2
+#else
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+size_t scoreRecommendationsScalar(const InventoryStore &inventory, size_t begin, size_t n,
+								  const ScoringContext &context, double threshold, int *rows, double *scores)
+{
+	return scoreRecommendationsWith<BalancedScoringPolicy>(inventory, begin, n, context, threshold, rows, scores);
+}
+
+#ifdef RECOMMENDATION_SIMD
+size_t scoreRecommendationsSse2(const InventoryStore &inventory, size_t begin, size_t n,
+								const ScoringContext &context, double threshold, int *rows, double *scores)
+{
+	const double *prices = &inventory.prices[begin];
+	const int *popularity = &inventory.popularity[begin];
+	const unsigned char *available = &inventory.available[begin];
+	const __m128d budgetV = _mm_set1_pd(context.budget), scaleV = _mm_set1_pd(RECOMMENDATION_POPULARITY_SCALE);
+	const __m128d budgetWeightV = _mm_set1_pd(RECOMMENDATION_BUDGET_WEIGHT);
+	const __m128d popularityWeightV = _mm_set1_pd(RECOMMENDATION_POPULARITY_WEIGHT);
+	const __m128d thresholdV = _mm_set1_pd(threshold), zeroV = _mm_setzero_pd();
+	size_t found = 0, i = 0;
+	for (; i + 2 <= n; i += 2)
+	{
+		__m128d price = _mm_loadu_pd(prices + i);
+		__m128d pop = _mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i *)(popularity + i)));
+		__m128d avail = _mm_set_pd(available[i + 1], available[i]);
+		__m128d score = _mm_add_pd(_mm_mul_pd(_mm_div_pd(_mm_sub_pd(budgetV, price), budgetV), budgetWeightV),
+								   _mm_mul_pd(_mm_div_pd(pop, scaleV), popularityWeightV));
+		__m128d pass = _mm_and_pd(_mm_and_pd(_mm_cmpgt_pd(avail, zeroV), _mm_cmple_pd(price, budgetV)),
+								  _mm_cmpge_pd(score, thresholdV));
+		int mask = _mm_movemask_pd(pass);
+		if (mask)
+		{
+			double lane[2];
+			_mm_storeu_pd(lane, score);
+			for (int bit = 0; bit < 2; bit++)
+			{
+				if (mask & (1 << bit))
+				{
+					rows[found] = (int)(i + bit);
+					scores[found++] = lane[bit];
+				}
+			}
+		}
+	}
+	size_t tail = scoreRecommendationsScalar(inventory, begin + i, n - i, context, threshold, rows + found, scores + found);
+	for (size_t t = found; t < found + tail; t++)
+		rows[t] += (int)i;
+	return found + tail;
+}
+
+SIMD_TARGET_AVX2 size_t scoreRecommendationsAvx2(const InventoryStore &inventory, size_t begin, size_t n,
+												 const ScoringContext &context, double threshold, int *rows, double *scores)
+{
+	const double *prices = &inventory.prices[begin];
+	const int *popularity = &inventory.popularity[begin];
+	const unsigned char *available = &inventory.available[begin];
+	const __m256d budgetV = _mm256_set1_pd(context.budget), scaleV = _mm256_set1_pd(RECOMMENDATION_POPULARITY_SCALE);
+	const __m256d budgetWeightV = _mm256_set1_pd(RECOMMENDATION_BUDGET_WEIGHT);
+	const __m256d popularityWeightV = _mm256_set1_pd(RECOMMENDATION_POPULARITY_WEIGHT);
+	const __m256d thresholdV = _mm256_set1_pd(threshold), zeroV = _mm256_setzero_pd();
+	size_t found = 0, i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		int availBytes;
+		memcpy(&availBytes, available + i, sizeof(availBytes));
+		__m256d price = _mm256_loadu_pd(prices + i);
+		__m256d pop = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)(popularity + i)));
+		__m256d avail = _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(availBytes)));
+		__m256d score = _mm256_add_pd(_mm256_mul_pd(_mm256_div_pd(_mm256_sub_pd(budgetV, price), budgetV), budgetWeightV),
+									  _mm256_mul_pd(_mm256_div_pd(pop, scaleV), popularityWeightV));
+		__m256d pass = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(avail, zeroV, _CMP_GT_OQ), _mm256_cmp_pd(price, budgetV, _CMP_LE_OQ)),
+									 _mm256_cmp_pd(score, thresholdV, _CMP_GE_OQ));
+		int mask = _mm256_movemask_pd(pass);
+		if (mask)
+		{
+			double lane[4];
+			_mm256_storeu_pd(lane, score);
+			for (int bit = 0; bit < 4; bit++)
+			{
+				if (mask & (1 << bit))
+				{
+					rows[found] = (int)(i + bit);
+					scores[found++] = lane[bit];
+				}
+			}
+		}
+	}
+	size_t tail = scoreRecommendationsScalar(inventory, begin + i, n - i, context, threshold, rows + found, scores + found);
+	for (size_t t = found; t < found + tail; t++)
+		rows[t] += (int)i;
+	return found + tail;
+}
+
+// AVX2 needs both the instructions (CPUID leaf 7) and OS support for saving
+// the 256-bit registers (OSXSAVE + XCR0)
+inline bool cpuHasAvx2()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	__cpuid(info, 1);
+	bool osSavesYmm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+	__cpuidex(info, 7, 0);
+	return osSavesYmm && (info[1] & (1 << 5));
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+struct RecommendationKernelChoice
+{
+	RecommendationKernel kernel;
+	const char *name;
+};
+
+// Best kernel for this CPU, detected once
+inline const RecommendationKernelChoice &recommendationKernel()
+{
+#ifdef RECOMMENDATION_SIMD
+	static const RecommendationKernelChoice choice = cpuHasAvx2()
+														 ? RecommendationKernelChoice{scoreRecommendationsAvx2, "AVX2"}
+														 : RecommendationKernelChoice{scoreRecommendationsSse2, "SSE2"};
+#else
+	static const RecommendationKernelChoice choice = {scoreRecommendationsScalar, "Scalar"};
+#endif
+	return choice;
+}
+
+size_t scoreRecommendationsDispatched(const InventoryStore &inventory, size_t begin, size_t n,
+									  const ScoringContext &context, double threshold, int *rows, double *scores)
+{
+	return recommendationKernel().kernel(inventory, begin, n, context, threshold, rows, scores);
+}
+
+// Policies selectable at runtime, each a separately compiled scan; the
+// balanced policy runs on the SIMD kernel picked for this CPU
+struct ScoringPolicyChoice
+{
+	const char *name;
+	RecommendationKernel kernel;
+	bool usesTime; // Rankings age, so they are never memoized
+};
+
+const ScoringPolicyChoice SCORING_POLICIES[] = {
+	{"Balanced (budget fit 70% + popularity 30%)", scoreRecommendationsDispatched, BalancedScoringPolicy::usesTime},
+	{"Budget fit", scoreRecommendationsWith<BudgetFitPolicy>, BudgetFitPolicy::usesTime},
+	{"Popularity", scoreRecommendationsWith<PopularityPolicy>, PopularityPolicy::usesTime},
+	{"Dealer margin (margin 60% + budget fit 40%)", scoreRecommendationsWith<MarginScoringPolicy>, MarginScoringPolicy::usesTime},
+	{"New arrivals (recency 50% + popularity 30% + budget fit 20%)", scoreRecommendationsWith<NewArrivalScoringPolicy>, NewArrivalScoringPolicy::usesTime},
+};
+const int SCORING_POLICY_COUNT = (int)(sizeof(SCORING_POLICIES) / sizeof(SCORING_POLICIES[0]));
+
+// Bounded min-heap of the best k recommendations seen so far. Its storage is
+// kept between queries, so a worker answering many budgets allocates once.
+class TopRecommendationBuffer
+{
+private:
+	vector<CarRecommendation> heap; // Worst of the current best k at heap[0]
+	size_t k;
+
+public:
+	TopRecommendationBuffer() : k(0) {}
+
+	void reset(size_t limit)
+	{
+		heap.clear();
+		k = limit;
+	}
+
+	// Score a candidate must reach to get in
+	double threshold() const
+	{
+		return heap.size() < k ? -numeric_limits<double>::infinity() : heap.front().score;
+	}
+
+	void offer(const CarRecommendation &candidate)
+	{
+		if (heap.size() < k)
+		{
+			heap.push_back(candidate);
+			push_heap(heap.begin(), heap.end(), greater<CarRecommendation>());
+		}
+		else if (k > 0 && candidate > heap.front())
+		{
+			pop_heap(heap.begin(), heap.end(), greater<CarRecommendation>());
+			heap.back() = candidate;
+			push_heap(heap.begin(), heap.end(), greater<CarRecommendation>());
+		}
+	}
+
+	// Move the contents out, best first; the buffer is left empty
+	void takeBestFirst(vector<CarRecommendation> &out)
+	{
+		sort_heap(heap.begin(), heap.end(), greater<CarRecommendation>());
+		out.assign(heap.begin(), heap.end());
+		heap.clear();
+	}
+};
+
+// Best k available cars within budget, best first, scored block by block
+// with the given kernel; the buffer's weakest score is the threshold for the
+// next block. Touches nothing but its arguments, so threads may call it
+// concurrently with their own buffers.
+void topRecommendations(const InventoryStore &inventory, const ScoringContext &context, size_t k, RecommendationKernel kernel,
+						TopRecommendationBuffer &best, vector<CarRecommendation> &results)
+{
+	best.reset(k);
+	if (k > 0 && context.budget > 0.0)
+	{
+		int rows[RECOMMENDATION_BLOCK];
+		double scores[RECOMMENDATION_BLOCK];
+		size_t total = inventory.size();
+		for (size_t base = 0; base < total; base += RECOMMENDATION_BLOCK)
+		{
+			size_t n = min(RECOMMENDATION_BLOCK, total - base);
+			size_t found = kernel(inventory, base, n, context, best.threshold(), rows, scores);
+			for (size_t i = 0; i < found; i++)
+			{
+				best.offer(CarRecommendation(inventory.carIDs[base + rows[i]], scores[i]));
+			}
+		}
+	}
+	best.takeBestFirst(results);
+}
+
+vector<CarRecommendation> topRecommendations(const InventoryStore &inventory, double budget, size_t k, RecommendationKernel kernel)
+{
+	TopRecommendationBuffer best;
+	vector<CarRecommendation> results;
+	topRecommendations(inventory, ScoringContext(budget, currentTimestamp()), k, kernel, best, results);
+	return results;
+}
+
+// 26. Parallel Batch Recommendations (one top-K list per budget)
+// Worker threads claim small runs of budgets from a shared atomic cursor,
+// so a slow run never leaves the other cores idle, and each keeps its own
+// top-K buffer. The inventory is only read; results[i] belongs to budgets[i]
+// and is written by exactly one worker.
+const size_t BATCH_RECOMMENDATION_CHUNK = 16; // Budgets claimed per cursor step
+
+vector<vector<CarRecommendation>> batchRecommendations(const InventoryStore &inventory, const vector<double> &budgets,
+													   size_t k, int threadCount, RecommendationKernel kernel)
+{
+	vector<vector<CarRecommendation>> results(budgets.size());
+	atomic<size_t> cursor(0);
+	Timestamp now = currentTimestamp(); // One clock for the whole batch
+	auto worker = [&]()
+	{
+		TopRecommendationBuffer best;
+		for (;;)
+		{
+			size_t first = cursor.fetch_add(BATCH_RECOMMENDATION_CHUNK, memory_order_relaxed);
+			if (first >= budgets.size())
+			{
+				break;
+			}
+			size_t last = min(first + BATCH_RECOMMENDATION_CHUNK, budgets.size());
+			for (size_t i = first; i < last; i++)
+			{
+				topRecommendations(inventory, ScoringContext(budgets[i], now), k, kernel, best, results[i]);
+			}
+		}
+	};
+
+	threadCount = max(1, min(threadCount, (int)((budgets.size() + BATCH_RECOMMENDATION_CHUNK - 1) / BATCH_RECOMMENDATION_CHUNK)));
+	vector<thread> helpers;
+	for (int t = 1; t < threadCount; t++)
+	{
+		helpers.push_back(thread(worker));
+	}
+	worker(); // The calling thread works too
+	for (thread &helper : helpers)
+	{
+		helper.join();
+	}
+	return results;
+}
+
+// Threads to use when the caller has no preference
+inline int defaultWorkerThreads()
+{
+	unsigned cores = thread::hardware_concurrency();
+	return cores ? (int)cores : 1;
+}
+
+// 27. Recommendation Memo (top-K per exact budget, invalidated by inventory version)
+// Remembers the top-K list of recently asked budgets with the inventory
+// version it was computed at. Scores depend on the exact budget, so a list
+// is only reused for the same budget and k; a budget quantized to a tier
+// would change the answer. The budget's RECOMMENDATION_BUDGET_STEP tier
+// only picks the memo slot, so one budget per tier is remembered and a
+// different budget in the same tier replaces it. Any inventory change bumps
+// the version, which drops every slot at the next lookup, so a hit is
+// always identical to a full scan and costs O(K) to copy out.
+const double RECOMMENDATION_BUDGET_STEP = 100.0; // Dollars per memo slot
+const size_t RECOMMENDATION_MEMO_SLOTS = 4096;	 // Slots kept before starting over
+
+class RecommendationMemo
+{
+private:
+	struct Slot
+	{
+		double budget; // Exact budget the picks were scored at
+		size_t k;
+		vector<CarRecommendation> picks;
+	};
+
+	unordered_map<long long, Slot> slots; // Budget tier -> last budget asked in it
+	unsigned long long version;			  // Inventory version the slots were computed at
+	long long hitCount, missCount, invalidationCount;
+
+public:
+	RecommendationMemo() : version(0), hitCount(0), missCount(0), invalidationCount(0) {}
+
+	// Remembered top-k for the budget; compute(budget) fills a miss and
+	// replaces whatever budget the tier's slot held
+	template <typename Compute>
+	const vector<CarRecommendation> &get(double budget, size_t k, unsigned long long inventoryVersion, Compute compute)
+	{
+		if (inventoryVersion != version)
+		{
+			if (!slots.empty())
+				invalidationCount++;
+			slots.clear();
+			version = inventoryVersion;
+		}
+
+		long long tier = (long long)floor(budget / RECOMMENDATION_BUDGET_STEP);
+		auto it = slots.find(tier);
+		if (it != slots.end() && it->second.budget == budget && it->second.k == k)
+		{
+			hitCount++;
+			return it->second.picks;
+		}
+
+		missCount++;
+		if (it == slots.end() && slots.size() >= RECOMMENDATION_MEMO_SLOTS)
+		{
+			slots.clear();
+		}
+		Slot &entry = slots[tier];
+		entry.budget = budget;
+		entry.k = k;
+		entry.picks = compute(budget);
+		return entry.picks;
+	}
+
+	void clear() { slots.clear(); }
+
+	size_t size() const { return slots.size(); }
+	long long hits() const { return hitCount; }
+	long long misses() const { return missCount; }
+	long long invalidations() const { return invalidationCount; }
+};
+
+// 28. Similar Cars Index (KD-trees over price and popularity, exact k nearest)
+// Each car is a point (price / SIMILAR_PRICE_UNIT, popularity /
+// SIMILAR_POPULARITY_UNIT); a different brand or body type adds a fixed
+// penalty to the squared distance. Cars are kept in one small KD-tree per
+// (brand, body type) group. A query searches its own group first, then only
+// the groups whose penalty alone is still below the current k-th best, so
+// most groups are never opened. Within a tree the distance to a splitting
+// plane bounds everything behind it, so the search stays exact. Inserts go
+// straight to a leaf and removals leave a tombstone; a tree is rebuilt
+// around medians when it gets too deep or mostly tombstones.
+const double SIMILAR_PRICE_UNIT = 5000.0;	// $5,000 apart counts as distance 1
+const double SIMILAR_POPULARITY_UNIT = 2.0; // Two popularity points apart counts as distance 1
+const double SIMILAR_BRAND_PENALTY = 1.0;	// Squared distance added for another brand
+const double SIMILAR_BODY_PENALTY = 4.0;	// Squared distance added for another body type
+const int SIMILAR_DEPTH_SLACK = 8;			// Depth allowed beyond 2 log2(n) before a rebuild
+
+struct SimilarCarFeatures
+{
+	double price;
+	int popularity;
+	int brandID;
+	int bodyTypeID;
+
+	SimilarCarFeatures(double p = 0.0, int pop = 0, int brand = 0, int body = 0)
+		: price(p), popularity(pop), brandID(brand), bodyTypeID(body) {}
+};
+
+class SimilarCarIndex
+{
+private:
+	typedef pair<double, int> Scored; // (squared distance, carID); worst on top, ties favour lower IDs
+
+	struct Node
+	{
+		double x, y;	 // Scaled price and popularity
+		int carID;
+		int left, right; // Children, -1 for none
+		bool removed;	 // Tombstone until the next rebuild
+	};
+
+	// KD-tree for one (brand, body type) group; even depths split on price,
+	// odd depths on popularity
+	struct Tree
+	{
+		int brandID, bodyTypeID;
+		vector<Node> nodes;
+		unordered_map<int, int> nodeByCarID; // Live cars only
+		int root;
+		size_t live;
+
+		Tree(int brand = 0, int body = 0) : brandID(brand), bodyTypeID(body), root(-1), live(0) {}
+
+		int build(vector<Node> &from, vector<int> &order, int lo, int hi, int depth)
+		{
+			if (lo >= hi)
+			{
+				return -1;
+			}
+			int mid = (lo + hi) / 2;
+			bool onY = depth % 2 == 1;
+			nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi, [&](int a, int b)
+						{ return onY ? from[a].y < from[b].y : from[a].x < from[b].x; });
+			int id = (int)nodes.size();
+			nodes.push_back(from[order[mid]]);
+			nodeByCarID[nodes[id].carID] = id;
+			int left = build(from, order, lo, mid, depth + 1);
+			int right = build(from, order, mid + 1, hi, depth + 1);
+			nodes[id].left = left;
+			nodes[id].right = right;
+			return id;
+		}
+
+		void rebuild()
+		{
+			vector<Node> from;
+			from.reserve(live);
+			for (const Node &node : nodes)
+			{
+				if (!node.removed)
+					from.push_back(node);
+			}
+			vector<int> order(from.size());
+			for (size_t i = 0; i < order.size(); i++)
+				order[i] = (int)i;
+
+			nodes.clear();
+			nodeByCarID.clear();
+			nodes.reserve(from.size());
+			root = build(from, order, 0, (int)from.size(), 0);
+		}
+
+		void insert(const Node &fresh)
+		{
+			int id = (int)nodes.size();
+			nodes.push_back(fresh);
+			nodeByCarID[fresh.carID] = id;
+			live++;
+			if (root == -1)
+			{
+				root = id;
+				return;
+			}
+
+			int parent = root, depth = 0;
+			for (;;)
+			{
+				Node &node = nodes[parent];
+				bool goLeft = depth % 2 == 1 ? fresh.y < node.y : fresh.x < node.x;
+				int &child = goLeft ? node.left : node.right;
+				depth++;
+				if (child == -1)
+				{
+					child = id;
+					break;
+				}
+				parent = child;
+			}
+
+			if (depth > 2 * (int)log2((double)live + 1) + SIMILAR_DEPTH_SLACK)
+			{
+				rebuild();
+			}
+		}
+
+		bool remove(int carID)
+		{
+			auto it = nodeByCarID.find(carID);
+			if (it == nodeByCarID.end())
+			{
+				return false;
+			}
+			nodes[it->second].removed = true;
+			nodeByCarID.erase(it);
+			live--;
+			if (nodes.size() > 2 * live + 64)
+			{
+				rebuild();
+			}
+			return true;
+		}
+
+		// Offer every car closer than the current k-th best; penalty is this
+		// group's fixed distance from the query
+		template <typename Accept>
+		void search(int id, int depth, double qx, double qy, double penalty, size_t k, int excludeCarID,
+					Accept &accept, priority_queue<Scored> &best) const
+		{
+			if (id == -1)
+			{
+				return;
+			}
+			const Node &node = nodes[id];
+			if (!node.removed && node.carID != excludeCarID && accept(node.carID))
+			{
+				double dx = node.x - qx, dy = node.y - qy;
+				Scored scored(dx * dx + dy * dy + penalty, node.carID);
+				if (best.size() < k)
+					best.push(scored);
+				else if (scored < best.top())
+				{
+					best.pop();
+					best.push(scored);
+				}
+			}
+
+			double diff = depth % 2 == 1 ? qy - node.y : qx - node.x;
+			int nearSide = diff < 0.0 ? node.left : node.right;
+			int farSide = diff < 0.0 ? node.right : node.left;
+			search(nearSide, depth + 1, qx, qy, penalty, k, excludeCarID, accept, best);
+			if (best.size() < k || diff * diff + penalty <= best.top().first)
+			{
+				search(farSide, depth + 1, qx, qy, penalty, k, excludeCarID, accept, best);
+			}
+		}
+	};
+
+	vector<Tree> groups;					   // One tree per (brand, body type)
+	unordered_map<long long, int> groupByKey; // (brand, body type) -> group
+	unordered_map<int, int> groupOfCar;		   // carID -> group
+	size_t live;
+
+	static long long groupKey(int brandID, int bodyTypeID)
+	{
+		return ((long long)brandID << 32) | (unsigned int)bodyTypeID;
+	}
+
+public:
+	SimilarCarIndex() : live(0) {}
+
+	// Add a car, or move it if its features changed
+	void insert(int carID, const SimilarCarFeatures &features)
+	{
+		remove(carID);
+		long long key = groupKey(features.brandID, features.bodyTypeID);
+		auto found = groupByKey.find(key);
+		int group = (int)groups.size();
+		if (found == groupByKey.end())
+		{
+			groupByKey[key] = group;
+			groups.push_back(Tree(features.brandID, features.bodyTypeID));
+		}
+		else
+		{
+			group = found->second;
+		}
+
+		Node fresh = {features.price / SIMILAR_PRICE_UNIT, features.popularity / SIMILAR_POPULARITY_UNIT, carID, -1, -1, false};
+		groups[group].insert(fresh);
+		groupOfCar[carID] = group;
+		live++;
+	}
+
+	bool remove(int carID)
+	{
+		auto it = groupOfCar.find(carID);
+		if (it == groupOfCar.end())
+		{
+			return false;
+		}
+		groups[it->second].remove(carID);
+		groupOfCar.erase(it);
+		live--;
+		return true;
+	}
+
+	// k cars nearest to the features, nearest first, as (carID, distance);
+	// accept(carID) filters candidates, excludeCarID is never returned
+	template <typename Accept>
+	vector<pair<int, double>> nearest(const SimilarCarFeatures &features, size_t k, int excludeCarID, Accept accept) const
+	{
+		vector<pair<int, double>> results;
+		if (k == 0)
+		{
+			return results;
+		}
+
+		// Groups by penalty, nearest first: same group, other brand, other body, both
+		vector<pair<double, int>> order;
+		order.reserve(groups.size());
+		for (size_t g = 0; g < groups.size(); g++)
+		{
+			if (groups[g].live == 0)
+				continue;
+			double penalty = (groups[g].brandID != features.brandID ? SIMILAR_BRAND_PENALTY : 0.0) +
+							 (groups[g].bodyTypeID != features.bodyTypeID ? SIMILAR_BODY_PENALTY : 0.0);
+			order.push_back(make_pair(penalty, (int)g));
+		}
+		sort(order.begin(), order.end());
+
+		double qx = features.price / SIMILAR_PRICE_UNIT, qy = features.popularity / SIMILAR_POPULARITY_UNIT;
+		priority_queue<Scored> best;
+		for (const pair<double, int> &entry : order)
+		{
+			if (best.size() == k && entry.first > best.top().first)
+			{
+				break; // Every remaining group is at least this far away
+			}
+			const Tree &tree = groups[entry.second];
+			tree.search(tree.root, 0, qx, qy, entry.first, k, excludeCarID, accept, best);
+		}
+
+		while (!best.empty())
+		{
+			results.push_back(make_pair(best.top().second, sqrt(best.top().first)));
+			best.pop();
+		}
+		reverse(results.begin(), results.end());
+		return results;
+	}
+
+	size_t size() const { return live; }
+	size_t groupCount() const { return groups.size(); }
+};
+
+// Car Dealership Management System Class
+class CarDealershipSystem
+{
+private:
+	// 1. Columnar Store for Car Inventory
+	InventoryStore inventory;
+
+	// 2. Flat Table for Customer Records
+	CustomerTable customerRecords;
+	CustomerContactIndex customerContacts; // Phone/email secondary indexes
+	NameTrigramIndex customerNames;		   // Fuzzy name search index
+	CustomerBudgetIndex customerBudgets;   // Customers ordered by budget
+
+	// 3. B+ Tree for Car Search & Sorting
+	PriceIndex priceIndex;
+
+	// 4. Slot Scheduler for Test Drive Requests
+	TestDriveScheduler testDriveSchedule;
+	MpmcRing<TestDriveRequest> testDriveIntake; // Thread-safe intake from sales terminals
+	TimestampFormatter slotTimeFormatter;		// Display text of test drive slots
+
+	// 5. Ring Buffer for Undo/Redo of Sales
+	SalesHistory salesHistory;
+	SalesJournal salesJournal; // Durable record of sales and undos
+	SalesRollups salesRollups; // Per model / color / day / month aggregates
+
+	// 6. Graph for Showroom Workflow
+	WorkflowGraph workflowGraph;
+	DealTracker dealTracker; // Each sale as a deal moving through the workflow
+
+	// 7. Top-K Car Recommendations (best first)
+	vector<CarRecommendation> recommendations;
+	RecommendationMemo recommendationMemo;	 // Repeat budgets served without a scan
+	int scoringPolicy;						 // Index into SCORING_POLICIES
+
+	// 8. KD-Tree for Similar Cars
+	SimilarCarIndex similarCars;
+
+	// Counters
+	int nextCarID;
+	int nextCustomerID;
+	int nextSaleID;
+
+public:
+	CarDealershipSystem() : testDriveIntake(TEST_DRIVE_INTAKE_CAPACITY), slotTimeFormatter("%b/%d/%Y %H:%M"),
+							salesHistory(SALES_HISTORY_CAPACITY), scoringPolicy(0), nextCarID(1), nextCustomerID(1), nextSaleID(1)
+	{
+		initializeWorkflowGraph();
+	}
+
+	// Initialize the workflow graph from the workflow file, or the default
+	// Sales -> Finance -> Service loop if the file is missing
+	void initializeWorkflowGraph()
+	{
+		if (!loadWorkflowGraph("Text Files/Workflow.txt"))
+		{
+			workflowGraph.addEdge("Sales", "Finance");	 // Sales -> Finance
+			workflowGraph.addEdge("Finance", "Service"); // Finance -> Service
+			workflowGraph.addEdge("Service", "Sales");	 // Service -> Sales (cycle)
+			dealTracker.reset(workflowGraph.size());
+		}
+	}
+
+	// Replace the workflow; deals in flight are dropped with the old graph
+	bool loadWorkflowGraph(const string &path)
+	{
+		if (!workflowGraph.loadFromFile(path))
+		{
+			return false;
+		}
+		dealTracker.reset(workflowGraph.size());
+		return true;
+	}
+
+	// 1. Columnar Store Operations - Car Inventory
+	// A cost of 0 means unknown; DEFAULT_DEALER_COST_SHARE of the price is assumed.
+	// An empty body type is recorded as "Unknown".
+	void addCarToInventory(string brand, string model, double price, int popularity = 0, double cost = 0.0,
+						   string bodyType = "")
+	{
+		addCarToInventory(nameDictionary.intern(brand), nameDictionary.intern(model), price, popularity, cost,
+						  nameDictionary.intern(bodyType.empty() ? "Unknown" : bodyType));
+	}
+
+	// Add a car whose brand/model names are already interned (body type -1 = "Unknown")
+	void addCarToInventory(int brandID, int modelID, double price, int popularity = 0, double cost = 0.0,
+						   int bodyTypeID = -1)
+	{
+		int carID = nextCarID++;
+		if (bodyTypeID == -1)
+		{
+			bodyTypeID = nameDictionary.intern("Unknown");
+		}
+		inventory.addCar(carID, brandID, modelID, price, true, popularity,
+						 cost > 0.0 ? cost : price * DEFAULT_DEALER_COST_SHARE, currentTimestamp(), bodyTypeID);
+		similarCars.insert(carID, SimilarCarFeatures(price, popularity, brandID, bodyTypeID));
+
+		// Also add to the price index for searching
+		priceIndex.insert(price, carID);
+	}
+
+	void removeCarFromInventory(int carID)
+	{
+		int row = inventory.rowOf(carID);
+		if (row != -1)
+		{
+			priceIndex.erase(inventory.prices[row], carID);
+			similarCars.remove(carID);
+			inventory.removeCar(carID);
+		}
+	}
+
+	// Change the price of a car, keeping the price index in sync
+	bool updateCarPrice(int carID, double newPrice)
+	{
+		int row = inventory.rowOf(carID);
+		if (row == -1)
+		{
+			return false;
+		}
+		priceIndex.updatePrice(inventory.prices[row], newPrice, carID);
+		inventory.setPrice(carID, newPrice);
+		similarCars.insert(carID, similarFeatures(row));
+		return true;
+	}
+
+	// First available inventory car of a model, or -1 if none is in stock
+	int availableCarOfModel(int modelID) const
+	{
+		for (size_t row = 0; row < inventory.size(); row++)
+		{
+			if (inventory.available[row] && inventory.modelIDs[row] == modelID)
+			{
+				return inventory.carIDs[row];
+			}
+		}
+		return -1;
+	}
+
+	// Update availability in both the inventory columns and the price index
+	void setCarAvailability(int carID, bool avail)
+	{
+		int row = inventory.rowOf(carID);
+		if (row != -1)
+		{
+			inventory.setAvailable(carID, avail);
+			priceIndex.setAvailable(inventory.prices[row], carID, avail);
+		}
+	}
+
+	// Change how popular a car is (0..10); recommendations see it at once
+	bool updateCarPopularity(int carID, int popularity)
+	{
+		if (!inventory.setPopularity(carID, popularity))
+		{
+			return false;
+		}
+		similarCars.insert(carID, similarFeatures(inventory.rowOf(carID)));
+		return true;
+	}
+
+	// Look up a single car by ID through the carID -> row index
+	bool findCar(int carID, CarNode &car)
+	{
+		int row = inventory.rowOf(carID);
+		if (row == -1)
+		{
+			return false;
+		}
+		car = inventory.getCar(row);
+		return true;
+	}
+
+	void displayCarInventory()
+	{
+		cout << "\n=== Car Inventory (Columnar Store) ===" << endl;
+		// Newest cars first, matching the order cars were added
+		for (int row = (int)inventory.size() - 1; row >= 0; row--)
+		{
+			cout << "ID: " << inventory.carIDs[row]
+				 << " | Brand: " << nameDictionary.nameOf(inventory.brandIDs[row])
+				 << " | Model: " << nameDictionary.nameOf(inventory.modelIDs[row])
+				 << " | Price: $" << inventory.prices[row]
+				 << " | Available: " << (inventory.available[row] ? "Yes" : "No") << endl;
+		}
+	}
+
+	// 2. Customer Table Operations - Customer Records
+	void registerCustomer(string name, string phone, string email, double budget)
+	{
+		customerRecords.put(Customer(nextCustomerID, name, phone, email, budget));
+		customerContacts.add(nextCustomerID, phone, email);
+		customerNames.add(nextCustomerID, name);
+		customerBudgets.add(nextCustomerID, budget);
+		nextCustomerID++;
+	}
+
+	// Change a customer's budget, keeping the budget index in sync
+	bool updateCustomerBudget(int customerID, double budget)
+	{
+		Customer *customer = customerRecords.find(customerID);
+		if (customer == nullptr)
+		{
+			return false;
+		}
+		customerBudgets.remove(customerID, customer->budget);
+		customer->budget = budget;
+		customerBudgets.add(customerID, budget);
+		return true;
+	}
+
+	// Rename a customer, keeping the trigram index in sync
+	bool updateCustomerName(int customerID, string name)
+	{
+		Customer *customer = customerRecords.find(customerID);
+		if (customer == nullptr)
+		{
+			return false;
+		}
+		customerNames.remove(customerID, customer->name);
+		customer->name = name;
+		customerNames.add(customerID, name);
+		return true;
+	}
+
+	// Top-K customers whose names are closest to a (possibly misspelled) query
+	vector<pair<int, double>> searchCustomersByName(const string &query, size_t k = 5)
+	{
+		return customerNames.search(query, k);
+	}
+
+	void displayCustomerNameSearch(const string &query, size_t k = 5)
+	{
+		cout << "\n=== Closest Names to \"" << query << "\" ===" << endl;
+		vector<pair<int, double>> matches = searchCustomersByName(query, k);
+		for (const pair<int, double> &match : matches)
+		{
+			Customer *c = customerRecords.find(match.first);
+			cout << "ID: " << c->customerID
+				 << " | Name: " << c->name
+				 << " | Phone: " << c->phone
+				 << " | Similarity: " << (int)(match.second * 100 + 0.5) << "%" << endl;
+		}
+		if (matches.empty())
+		{
+			cout << "No similar names found." << endl;
+		}
+	}
+
+	// Edit a customer's phone and email, keeping the secondary indexes in sync
+	bool updateCustomerContact(int customerID, string phone, string email)
+	{
+		Customer *customer = customerRecords.find(customerID);
+		if (customer == nullptr)
+		{
+			return false;
+		}
+		customerContacts.remove(customerID, customer->phone, customer->email);
+		customer->phone = phone;
+		customer->email = email;
+		customerContacts.add(customerID, phone, email);
+		return true;
+	}
+
+	vector<int> findCustomersByPhone(const string &phone) const { return customerContacts.findByPhone(phone); }
+	vector<int> findCustomersByEmail(const string &email) const { return customerContacts.findByEmail(email); }
+	vector<int> findCustomersByPhonePrefix(const string &prefix, size_t limit = 20) const { return customerContacts.phonePrefix(prefix, limit); }
+	vector<int> findCustomersByEmailPrefix(const string &prefix, size_t limit = 20) const { return customerContacts.emailPrefix(prefix, limit); }
+
+	// Counter lookup: email prefix if the query has letters or '@', phone prefix otherwise
+	void displayCustomerLookup(const string &query)
+	{
+		bool isEmail = false;
+		for (char c : query)
+		{
+			if (isalpha((unsigned char)c) || c == '@')
+				isEmail = true;
+		}
+		vector<int> ids = isEmail ? findCustomersByEmailPrefix(query) : findCustomersByPhonePrefix(query);
+
+		cout << "\n=== Customers Matching \"" << query << "\" ===" << endl;
+		for (int id : ids)
+		{
+			Customer *c = customerRecords.find(id);
+			cout << "ID: " << c->customerID
+				 << " | Name: " << c->name
+				 << " | Phone: " << c->phone
+				 << " | Email: " << c->email << endl;
+		}
+		if (ids.empty())
+		{
+			cout << "No matching customers." << endl;
+		}
+	}
+
+	Customer *findCustomer(int customerID)
+	{
+		return customerRecords.find(customerID);
+	}
+
+	void displayCustomers()
+	{
+		cout << "\n=== Customer Records (Customer Table) ===" << endl;
+		for (Customer &c : customerRecords)
+		{
+			cout << "ID: " << c.customerID
+				 << " | Name: " << c.name
+				 << " | Phone: " << c.phone
+				 << " | Budget: $" << c.budget << endl;
+		}
+	}
+
+	// 3. B+ Tree Operations - Car Search & Sorting
+	void displayCarsSortedByPrice()
+	{
+		cout << "\n=== Cars Sorted by Price (B+ Tree) ===" << endl;
+		priceIndex.forEach([this](const PriceKey &key)
+		{
+			int row = inventory.rowOf(key.carID);
+			cout << "ID: " << key.carID
+				 << " | " << nameDictionary.nameOf(inventory.brandIDs[row])
+				 << " " << nameDictionary.nameOf(inventory.modelIDs[row])
+				 << " | Price: $" << key.price << endl;
+		});
+	}
+
+	// Lazy cursor over available cars priced within [minPrice, maxPrice]
+	PriceRangeCursor carsInPriceRange(double minPrice, double maxPrice) const
+	{
+		return priceIndex.rangeQuery(minPrice, maxPrice);
+	}
+
+	// Paginated price range query (offset/limit over available cars)
+	vector<CarNode> queryCarsInPriceRange(double minPrice, double maxPrice, size_t offset = 0, size_t limit = 20)
+	{
+		vector<CarNode> cars;
+		vector<PriceKey> page = priceIndex.rangePage(minPrice, maxPrice, offset, limit);
+		for (const PriceKey &key : page)
+		{
+			cars.push_back(inventory.getCar(inventory.rowOf(key.carID)));
+		}
+		return cars;
+	}
+
+	// k-th cheapest available car (1 = cheapest)
+	bool kthCheapestAvailableCar(int k, CarNode &car)
+	{
+		PriceKey key;
+		if (!priceIndex.kthAvailable(k - 1, key))
+		{
+			return false;
+		}
+		car = inventory.getCar(inventory.rowOf(key.carID));
+		return true;
+	}
+
+	// Price rank of a car among available stock (1 = cheapest), 0 if unknown
+	int priceRankOfCar(int carID)
+	{
+		int row = inventory.rowOf(carID);
+		if (row == -1)
+		{
+			return 0;
+		}
+		return priceIndex.rankOf(inventory.prices[row], carID) + 1;
+	}
+
+	// Price at a percentile (0 - 100) of available stock
+	bool availablePricePercentile(double percentile, double &price)
+	{
+		return priceIndex.pricePercentile(percentile / 100.0, price);
+	}
+
+	void displayPriceStatistics()
+	{
+		cout << "\n=== Available Stock Price Statistics ===" << endl;
+		double median = 0.0, p90 = 0.0;
+		if (!availablePricePercentile(50, median) || !availablePricePercentile(90, p90))
+		{
+			cout << "No available cars in inventory." << endl;
+			return;
+		}
+		cout << "Available cars: " << priceIndex.availableCount() << endl;
+		cout << "Median price: $" << median << endl;
+		cout << "90th percentile price: $" << p90 << endl;
+	}
+
+	// Allocation statistics of pooled storage and inventory columns
+	// One line per slab pool: lifetime counts, then the pages behind them
+	template <typename T>
+	static void displayPoolStats(const string &name, const SlabPool<T> &pool)
+	{
+		cout << name << " pool (" << sizeof(T) << " B each): Allocated: " << pool.allocations()
+			 << " | Released: " << pool.releases()
+			 << " | Live: " << pool.live()
+			 << " | Pages: " << pool.pageCount()
+			 << " | Bytes reserved: " << pool.bytesReserved() << endl;
+	}
+
+	void displayMemoryStats()
+	{
+		size_t rows = inventory.size();
+		size_t columnBytes = inventory.carIDs.capacity() * sizeof(int) + inventory.prices.capacity() * sizeof(double) +
+							 inventory.popularity.capacity() * sizeof(int) + inventory.available.capacity() +
+							 inventory.brandIDs.capacity() * sizeof(int) + inventory.modelIDs.capacity() * sizeof(int) +
+							 inventory.costs.capacity() * sizeof(double) + inventory.addedAt.capacity() * sizeof(Timestamp) +
+							 inventory.bodyTypeIDs.capacity() * sizeof(int);
+
+		cout << "\n=== Memory Statistics ===" << endl;
+		cout << "Inventory rows: " << rows << " | Column bytes reserved: " << columnBytes << endl;
+		displayPoolStats("Price index node", priceIndex.pool());
+		cout << "Sales history ring slots: " << salesHistory.capacity()
+			 << " | In effect: " << salesHistory.size()
+			 << " | Bytes reserved: " << salesHistory.capacity() * (sizeof(SaleTransaction) + sizeof(unsigned char)) << endl;
+		cout << "Pending test drives: " << testDriveSchedule.pendingCount() + testDriveIntake.size() << endl;
+		cout << "Sales journal records: " << salesJournal.records()
+			 << " | Commits: " << salesJournal.commits() << endl;
+		cout << "Recommendation memo slots: " << recommendationMemo.size()
+			 << " | Hits: " << recommendationMemo.hits()
+			 << " | Misses: " << recommendationMemo.misses()
+			 << " | Invalidations: " << recommendationMemo.invalidations() << endl;
+	}
+
+	void displayCarsInPriceRange(double minPrice, double maxPrice, size_t offset = 0, size_t limit = 20)
+	{
+		cout << "\n=== Available Cars From $" << minPrice << " To $" << maxPrice << " ===" << endl;
+		vector<CarNode> cars = queryCarsInPriceRange(minPrice, maxPrice, offset, limit);
+		for (const CarNode &car : cars)
+		{
+			cout << "ID: " << car.carID
+				 << " | " << car.brand() << " " << car.model()
+				 << " | Price: $" << car.price << endl;
+		}
+		if (cars.empty())
+		{
+			cout << "No available cars in this price range." << endl;
+		}
+	}
+
+	// 4. Scheduler Operations - Test Drive Requests
+	void requestTestDrive(int customerID, int carID)
+	{
+		requestTestDrive(customerID, carID, currentTimestamp());
+	}
+
+	// True if a car is in the inventory and not sold
+	bool canTestDrive(int carID) const
+	{
+		int row = inventory.rowOf(carID);
+		return row != -1 && inventory.available[row];
+	}
+
+	// Book the first free slot of a car at or after a preferred time; -1 if
+	// the car does not exist or is sold
+	Timestamp requestTestDrive(int customerID, int carID, Timestamp preferredStart)
+	{
+		if (!canTestDrive(carID))
+		{
+			cout << "Car ID " << carID << " is not available for a test drive." << endl;
+			return -1;
+		}
+		Timestamp slot = testDriveSchedule.book(customerID, carID, preferredStart, currentTimestamp());
+		cout << "Test drive booked for Car ID " << carID << " at " << formatSlot(slot) << endl;
+		return slot;
+	}
+
+	// Queue a request from any thread without locking; it is booked into the
+	// schedule on the next drain. False if the car does not exist or is sold,
+	// or if the intake ring is full.
+	bool submitTestDriveRequest(int customerID, int carID, Timestamp preferredStart = 0)
+	{
+		if (!canTestDrive(carID))
+		{
+			return false;
+		}
+		Timestamp now = currentTimestamp();
+		return testDriveIntake.tryEnqueue(TestDriveRequest(customerID, carID, preferredStart ? preferredStart : now, now));
+	}
+
+	// Book every queued intake request, TEST_DRIVE_DRAIN_BATCH at a time, and
+	// return how many were booked; a car sold or removed since its request was
+	// queued is checked again here and the request dropped
+	size_t drainTestDriveIntake()
+	{
+		TestDriveRequest batch[TEST_DRIVE_DRAIN_BATCH];
+		size_t booked = 0, taken;
+		while ((taken = testDriveIntake.tryDequeueBulk(batch, TEST_DRIVE_DRAIN_BATCH)) > 0)
+		{
+			for (size_t i = 0; i < taken; i++)
+			{
+				if (canTestDrive(batch[i].carID))
+				{
+					testDriveSchedule.book(batch[i].customerID, batch[i].carID, batch[i].slotStart, batch[i].requestTime);
+					booked++;
+				}
+			}
+		}
+		return booked;
+	}
+
+	bool cancelTestDrive(int carID, Timestamp slotStart)
+	{
+		return testDriveSchedule.cancel(carID, slotStart);
+	}
+
+	Timestamp nextFreeTestDriveSlot(int carID, Timestamp from)
+	{
+		return testDriveSchedule.nextFreeSlot(carID, from);
+	}
+
+	// Available cars with no test drive booked in the slot containing a time:
+	// the busy cars come from one range lookup in the scheduler's time index,
+	// and the answer is their complement in the available column. Listing the
+	// complement is O(cars) by nature; no per-car schedule lookup is made.
+	vector<int> carsFreeForTestDrive(Timestamp t)
+	{
+		vector<unsigned char> busy(inventory.size(), 0);
+		vector<int> busyCars = testDriveSchedule.busyCarsAt(t);
+		for (size_t i = 0; i < busyCars.size(); i++)
+		{
+			int row = inventory.rowOf(busyCars[i]);
+			if (row != -1)
+			{
+				busy[row] = 1;
+			}
+		}
+
+		vector<int> cars;
+		for (size_t row = 0; row < inventory.size(); row++)
+		{
+			if (inventory.available[row] && !busy[row])
+			{
+				cars.push_back(inventory.carIDs[row]);
+			}
+		}
+		return cars;
+	}
+
+	const string &formatSlot(Timestamp slot)
+	{
+		return slotTimeFormatter.format(slot);
+	}
+
+	// Serve pending drives earliest slot first
+	void processNextTestDrive()
+	{
+		drainTestDriveIntake();
+		TestDriveRequest request;
+		if (testDriveSchedule.popNext(request))
+		{
+			cout << "Processing test drive for Customer ID: " << request.customerID
+				 << " Car ID: " << request.carID
+				 << " Slot: " << formatSlot(request.slotStart) << endl;
+		}
+		else
+		{
+			cout << "No test drive requests in queue." << endl;
+		}
+	}
+
+	void displayTestDriveQueue()
+	{
+		drainTestDriveIntake();
+		cout << "\n=== Test Drive Schedule ===" << endl;
+		cout << "Pending drives: " << testDriveSchedule.pendingCount() << endl;
+		testDriveSchedule.forEachPending([this](const TestDriveRequest &request)
+		{
+			cout << formatSlot(request.slotStart)
+				 << " | Car ID: " << request.carID
+				 << " | Customer ID: " << request.customerID << endl;
+		});
+	}
+
+	// 5. Ring Buffer Operations - Undo/Redo Sales
+	// Rebuild the sales history, rollups and car availability from the journal,
+	// then keep appending to it. Returns the number of records replayed.
+	size_t openSalesJournal(const string &path)
+	{
+		size_t mismatched = 0;
+		size_t replayed = salesJournal.open(path, [this, &mismatched](const SalesJournalRecord &record)
+		{
+			SaleTransaction sale(0, 0, 0, 0.0, 0);
+			if (record.type == SALES_JOURNAL_SALE)
+			{
+				// Car IDs follow load order, so a journaled ID may now name a
+				// different car; such a sale is kept but not tied to inventory
+				int carID = record.carID;
+				if (carID != -1 && !journaledCarMatches(carID, record.model))
+				{
+					carID = -1;
+					mismatched++;
+				}
+				sale = SaleTransaction(record.saleID, record.customerID, carID, record.amount, record.time,
+									   nameDictionary.intern(record.model), nameDictionary.intern(record.color));
+				salesHistory.push(sale);
+				salesRollups.add(sale);
+				setCarAvailability(carID, false);
+				nextSaleID = max(nextSaleID, record.saleID + 1);
+			}
+			else if (record.type == SALES_JOURNAL_IMPORT)
+			{
+				salesRollups.add(SaleTransaction(record.saleID, 0, 0, record.amount, record.time,
+												 nameDictionary.intern(record.model), nameDictionary.intern(record.color)));
+				nextSaleID = max(nextSaleID, record.saleID + 1);
+			}
+			else if (record.type == SALES_JOURNAL_UNDO && salesHistory.undoByID(record.saleID, sale))
+			{
+				salesRollups.remove(sale);
+				setCarAvailability(sale.carID, true);
+			}
+			else if (record.type == SALES_JOURNAL_REDO && salesHistory.redoLast(sale))
+			{
+				salesRollups.add(sale);
+				setCarAvailability(sale.carID, false);
+			}
+		});
+		if (mismatched > 0)
+		{
+			cout << "Warning: " << mismatched << " journaled sale(s) name a car ID that is now a different model; "
+				 << "those cars were left available." << endl;
+		}
+		return replayed;
+	}
+
+	// True if carID is in inventory and its model is the one a journal
+	// record stored (compared over the record's truncated name field)
+	bool journaledCarMatches(int carID, const char *model) const
+	{
+		int row = inventory.rowOf(carID);
+		return row != -1 &&
+			   nameDictionary.nameOf(inventory.modelIDs[row]).compare(0, SALES_JOURNAL_NAME_SIZE - 1, model) == 0;
+	}
+
+	// Sales in effect as stored in the journal, for the order-log screen
+	vector<SalesJournalRecord> orderLog() const { return salesJournal.salesInEffect(); }
+
+	// Journal the orders in a text order log ("date time model color price"
+	// per line), for sales made before the journal existed. The orders are
+	// not tied to inventory cars and only feed the rollups: they are kept out
+	// of the undo/redo history, since there is no car to put back in stock.
+	size_t importOrderLog(const string &path)
+	{
+		ifstream orderLog(path);
+		string date, clock, model, color;
+		double price;
+		size_t imported = 0;
+		salesJournal.beginGroup();
+		while (orderLog >> date >> clock >> model >> color >> price)
+		{
+			tm parts = {};
+			istringstream stamp(date + " " + clock);
+			stamp >> get_time(&parts, "%b/%d/%Y %H:%M:%S");
+			parts.tm_isdst = -1;
+			Timestamp when = stamp.fail() ? 0 : (Timestamp)mktime(&parts);
+
+			SaleTransaction sale(nextSaleID++, 0, 0, price, when, nameDictionary.intern(model), nameDictionary.intern(color));
+			salesRollups.add(sale);
+			salesJournal.append(SalesJournalRecord(SALES_JOURNAL_IMPORT, sale));
+			imported++;
+		}
+		salesJournal.endGroup();
+		return imported;
+	}
+
+	// Sales recorded between these calls share one journal commit
+	void beginSalesGroup() { salesJournal.beginGroup(); }
+	void endSalesGroup() { salesJournal.endGroup(); }
+
+	// Model and color default to the inventory car's model and "Unknown"
+	void recordSale(int customerID, int carID, double amount, int modelID = -1, int colorID = -1)
+	{
+		if (modelID < 0)
+		{
+			int row = inventory.rowOf(carID);
+			modelID = row != -1 ? inventory.modelIDs[row] : nameDictionary.intern("Unknown");
+		}
+		if (colorID < 0)
+		{
+			colorID = nameDictionary.intern("Unknown");
+		}
+
+		SaleTransaction sale(nextSaleID++, customerID, carID, amount, currentTimestamp(), modelID, colorID);
+		salesHistory.push(sale);
+		salesRollups.add(sale);
+		salesJournal.append(SalesJournalRecord(SALES_JOURNAL_SALE, sale));
+		dealTracker.open(sale.saleID, dealEntryDepartment(), sale.saleTime);
+
+		// Mark car as sold
+		setCarAvailability(carID, false);
+
+		cout << "Sale recorded successfully!" << endl;
+	}
+
+	// Journal an undo/redo, update the rollups and flip the car's state
+	// through the carID index
+	void applySaleChange(int type, const SaleTransaction &sale)
+	{
+		salesJournal.append(SalesJournalRecord(type, sale));
+		if (type == SALES_JOURNAL_UNDO)
+		{
+			salesRollups.remove(sale);
+			dealTracker.cancel(sale.saleID);
+		}
+		else
+		{
+			salesRollups.add(sale);
+			dealTracker.reopen(sale.saleID, dealEntryDepartment(), currentTimestamp());
+		}
+		setCarAvailability(sale.carID, type == SALES_JOURNAL_UNDO);
+	}
+
+	void undoLastSale()
+	{
+		SaleTransaction lastSale(0, 0, 0, 0.0, 0);
+		if (salesHistory.undoLast(lastSale))
+		{
+			applySaleChange(SALES_JOURNAL_UNDO, lastSale);
+			cout << "Last sale undone! Car ID " << lastSale.carID << " is now available." << endl;
+		}
+		else
+		{
+			cout << "No sales to undo." << endl;
+		}
+	}
+
+	// Undo up to count of the newest sales with a single journal commit
+	size_t undoLastSales(size_t count)
+	{
+		SaleTransaction sale(0, 0, 0, 0.0, 0);
+		size_t undoneCount = 0;
+		salesJournal.beginGroup();
+		while (undoneCount < count && salesHistory.undoLast(sale))
+		{
+			applySaleChange(SALES_JOURNAL_UNDO, sale);
+			undoneCount++;
+		}
+		salesJournal.endGroup();
+		return undoneCount;
+	}
+
+	// Undo one sale anywhere in the history; false if unknown or already undone
+	bool undoSale(int saleID)
+	{
+		SaleTransaction sale(0, 0, 0, 0.0, 0);
+		if (!salesHistory.undoByID(saleID, sale))
+		{
+			return false;
+		}
+		applySaleChange(SALES_JOURNAL_UNDO, sale);
+		return true;
+	}
+
+	// Redo up to count of the most recently undone sales
+	size_t redoSales(size_t count)
+	{
+		SaleTransaction sale(0, 0, 0, 0.0, 0);
+		size_t redoneCount = 0;
+		salesJournal.beginGroup();
+		while (redoneCount < count && salesHistory.redoLast(sale))
+		{
+			applySaleChange(SALES_JOURNAL_REDO, sale);
+			redoneCount++;
+		}
+		salesJournal.endGroup();
+		return redoneCount;
+	}
+
+	const SalesRollups &salesSummary() const { return salesRollups; }
+
+	void displaySalesRollups()
+	{
+		const SalesAggregate &all = salesRollups.overall();
+		cout << "\n=== Sales Summary (in effect) ===" << endl;
+		cout << "Sales: " << all.count << " | Revenue: " << fixed << setprecision(0) << all.revenue
+			 << " | Min: " << all.minPrice() << " | Max: " << all.maxPrice() << endl;
+
+		auto printGroup = [](const string &label, const SalesAggregate &group)
+		{
+			cout << setw(12) << left << label << right
+				 << " | Sales: " << setw(4) << group.count
+				 << " | Revenue: " << setw(12) << group.revenue
+				 << " | Min: " << setw(10) << group.minPrice()
+				 << " | Max: " << setw(10) << group.maxPrice() << endl;
+		};
+
+		cout << "\n--- By Model ---" << endl;
+		for (const auto &entry : salesRollups.models())
+			printGroup(nameDictionary.nameOf(entry.first), entry.second);
+		cout << "\n--- By Color ---" << endl;
+		for (const auto &entry : salesRollups.colors())
+			printGroup(nameDictionary.nameOf(entry.first), entry.second);
+		cout << "\n--- By Month ---" << endl;
+		for (const auto &entry : salesRollups.months())
+			printGroup(to_string(entry.first / 100) + "-" + (entry.first % 100 < 10 ? "0" : "") + to_string(entry.first % 100), entry.second);
+
+		cout.unsetf(ios::fixed);
+		cout << setprecision(6);
+	}
+
+	void displaySalesHistoryStatus()
+	{
+		cout << "Sales in effect: " << salesHistory.size()
+			 << " | Redo available: " << salesHistory.redoable()
+			 << " | History capacity: " << salesHistory.capacity() << endl;
+	}
+
+	// 6. Graph Operations - Workflow Management
+	const WorkflowGraph &workflow() const { return workflowGraph; }
+
+	void displayWorkflow()
+	{
+		cout << "\n=== Showroom Workflow (Graph) ===" << endl;
+		for (int dept = 0; dept < workflowGraph.size(); dept++)
+		{
+			cout << dept << ": " << workflowGraph.nameOf(dept) << " -> ";
+			for (int slot = workflowGraph.edgesBegin(dept); slot < workflowGraph.edgesEnd(dept); slot++)
+			{
+				cout << workflowGraph.nameOf(workflowGraph.target(slot)) << " ";
+			}
+			cout << endl;
+		}
+	}
+
+	// BFS for workflow process
+	void bfsWorkflow(int startDept)
+	{
+		cout << "\n=== BFS Workflow Process ===" << endl;
+		for (int dept : workflowGraph.bfs(startDept))
+		{
+			cout << "Processing: " << workflowGraph.nameOf(dept) << endl;
+		}
+	}
+
+	void displayWorkflowPath(const string &from, const string &to)
+	{
+		int cost = 0;
+		vector<int> path = workflowGraph.shortestPath(workflowGraph.idOf(from), workflowGraph.idOf(to), cost);
+		cout << "\n=== Workflow Path: " << from << " to " << to << " ===" << endl;
+		if (path.empty())
+		{
+			cout << "No path between these departments." << endl;
+			return;
+		}
+		for (size_t i = 0; i < path.size(); i++)
+		{
+			cout << (i ? " -> " : "") << workflowGraph.nameOf(path[i]);
+		}
+		cout << " (cost " << cost << ")" << endl;
+	}
+
+	// New deals enter at "Sales", or the first department if there is none
+	int dealEntryDepartment() const
+	{
+		int sales = workflowGraph.idOf("Sales");
+		return sales != -1 ? sales : (workflowGraph.size() > 0 ? 0 : -1);
+	}
+
+	// Finish the department's oldest deal in progress, handing it to nextDept
+	// (-1 = the preferred edge), and start its next waiting deal; false if
+	// there was nothing to do or nextDept is not an edge out of dept
+	bool advanceDepartment(int dept, Timestamp now, int nextDept = -1)
+	{
+		if (dept < 0 || dept >= workflowGraph.size() || (nextDept != -1 && !workflowGraph.hasEdge(dept, nextDept)))
+		{
+			return false;
+		}
+		int current = dealTracker.oldestInProgress(dept);
+		bool finished = current != -1 && dealTracker.finish(current, workflowGraph, now, nextDept);
+		int next = 0;
+		bool started = dealTracker.startNext(dept, now, next);
+		return finished || started;
+	}
+
+	const DealTracker &deals() const { return dealTracker; }
+
+	void displayDealWorkflow()
+	{
+		cout << "\n=== Deal Workflow ===" << endl;
+		cout << "Open deals: " << dealTracker.openDeals()
+			 << " | Closed deals: " << dealTracker.closedDeals()
+			 << " | Avg sale-to-close: " << dealTracker.averageCycleTime() / 60.0 << " min" << endl;
+		for (int dept = 0; dept < workflowGraph.size(); dept++)
+		{
+			const DepartmentStats &st = dealTracker.department(dept);
+			cout << dept << ": " << workflowGraph.nameOf(dept)
+				 << " | Waiting: " << st.queueLength
+				 << " (max " << st.maxQueueLength << ")"
+				 << " | In progress: " << dealTracker.inProgress(dept)
+				 << " | Done: " << st.completed
+				 << " | Avg wait: " << st.averageWait() / 60.0 << " min"
+				 << " | Avg service: " << st.averageService() / 60.0 << " min"
+				 << " | Throughput: " << st.throughputPerHour() << "/h" << endl;
+		}
+
+		int worst = dealTracker.bottleneck();
+		int peak = dealTracker.peakHour();
+		if (worst != -1)
+		{
+			cout << "Bottleneck overall: " << workflowGraph.nameOf(worst) << endl;
+		}
+		if (peak != -1)
+		{
+			cout << "Bottleneck at peak hour " << peak << ":00: "
+				 << workflowGraph.nameOf(dealTracker.bottleneck(peak)) << endl;
+		}
+	}
+
+	// Sales in history and pending test drives, as simulator arrivals
+	vector<SimulationArrival> recordedArrivals() const
+	{
+		vector<SimulationArrival> arrivals;
+		salesHistory.forEachActive([&arrivals](const SaleTransaction &sale)
+								   { arrivals.push_back(SimulationArrival(sale.saleTime, SIM_SALE)); });
+		testDriveSchedule.forEachPending([&arrivals](const TestDriveRequest &request)
+										 { arrivals.push_back(SimulationArrival(request.requestTime, SIM_TEST_DRIVE)); });
+		return arrivals;
+	}
+
+	// Run the capacity simulator on the current workflow; sales enter at the
+	// deal entry department and test drives are run by the same department
+	SimulationResult simulateWorkflow(SimulationConfig config) const
+	{
+		config.entryDept = config.testDriveDept = dealEntryDepartment();
+		WorkflowSimulator simulator(workflowGraph, config);
+		return simulator.run();
+	}
+
+	void displaySimulation(const SimulationConfig &config, const SimulationResult &result) const
+	{
+		cout << "\n=== Workflow Simulation ===" << endl;
+		cout << fixed << setprecision(1);
+		cout << "Simulated " << result.span / 86400.0 << " days, " << result.customers << " customers, "
+			 << result.events << " events in " << result.elapsedMs << " ms" << endl;
+		for (int dept = 0; dept < (int)result.departments.size(); dept++)
+		{
+			const SimulationDeptResult &out = result.departments[dept];
+			int staff = dept < (int)config.staff.size() ? config.staff[dept] : 1;
+			cout << workflowGraph.nameOf(dept) << " (" << staff << " staff)"
+				 << " | Visits: " << out.served
+				 << " | Avg wait: " << out.averageWait / 60.0 << " min"
+				 << " | P95 wait: " << out.p95Wait / 60.0 << " min"
+				 << " | Max wait: " << out.maxWait / 60.0 << " min"
+				 << " | Avg queue: " << out.averageQueue
+				 << " | Max queue: " << out.maxQueue
+				 << " | Utilization: " << out.utilization * 100.0 << "%"
+				 << " | Overtime: " << out.overtimeHours << " h" << endl;
+		}
+		cout << "Customer time in showroom: avg " << result.averageLatency / 60.0
+			 << " min, p95 " << result.p95Latency / 60.0 << " min" << endl;
+		cout.unsetf(ios::fixed);
+		cout << setprecision(6);
+	}
+
+	void displayWorkflowCycle()
+	{
+		vector<int> cycle = workflowGraph.findCycle();
+		if (cycle.empty())
+		{
+			cout << "Workflow has no cycles." << endl;
+			return;
+		}
+		cout << "Workflow cycle: ";
+		for (size_t i = 0; i < cycle.size(); i++)
+		{
+			cout << (i ? " -> " : "") << workflowGraph.nameOf(cycle[i]);
+		}
+		cout << endl;
+	}
+
+	// 7. Top-K Car Recommendations
+	// Best k available cars within budget, best first, as (carID, score)
+	vector<CarRecommendation> recommendCars(double customerBudget, size_t k = RECOMMENDATION_COUNT) const
+	{
+		return topRecommendations(inventory, customerBudget, k, SCORING_POLICIES[scoringPolicy].kernel);
+	}
+
+	// One top-k list per budget, computed on threadCount threads; reentrant,
+	// touches no member state but reads the inventory
+	vector<vector<CarRecommendation>> recommendForBudgets(const vector<double> &budgets, size_t k = RECOMMENDATION_COUNT,
+														  int threadCount = defaultWorkerThreads()) const
+	{
+		return batchRecommendations(inventory, budgets, k, threadCount, SCORING_POLICIES[scoringPolicy].kernel);
+	}
+
+	// Top-k cars for every registered customer, written one customer per line
+	// as "customerID<TAB>name<TAB>carID:score ..."; returns customers written or -1
+	int exportCustomerRecommendations(const string &path, size_t k = RECOMMENDATION_COUNT, int threadCount = defaultWorkerThreads())
+	{
+		vector<const Customer *> customers;
+		vector<double> budgets;
+		for (Customer &c : customerRecords)
+		{
+			customers.push_back(&c);
+			budgets.push_back(c.budget);
+		}
+
+		vector<vector<CarRecommendation>> lists = recommendForBudgets(budgets, k, threadCount);
+
+		ofstream out(path.c_str());
+		if (!out)
+		{
+			return -1;
+		}
+		for (size_t i = 0; i < customers.size(); i++)
+		{
+			out << customers[i]->customerID << '\t' << customers[i]->name;
+			for (const CarRecommendation &rec : lists[i])
+			{
+				out << '\t' << rec.carID << ':' << rec.score;
+			}
+			out << '\n';
+		}
+		return out ? (int)customers.size() : -1;
+	}
+
+	// Top-k for a budget through the memo: the inventory is scanned only when
+	// it changed since this budget was last asked for, or another budget in the
+	// same RECOMMENDATION_BUDGET_STEP tier took its slot. A policy that scores
+	// on the current time always scans. Same list as recommendCars.
+	vector<CarRecommendation> memoizedRecommendations(double customerBudget, size_t k = RECOMMENDATION_COUNT)
+	{
+		if (SCORING_POLICIES[scoringPolicy].usesTime)
+		{
+			return recommendCars(customerBudget, k);
+		}
+		return recommendationMemo.get(customerBudget, k, inventory.version, [&](double budget)
+									  { return recommendCars(budget, k); });
+	}
+
+	void generateRecommendations(double customerBudget)
+	{
+		recommendations = memoizedRecommendations(customerBudget);
+	}
+
+	const RecommendationMemo &recommendationMemoStats() const { return recommendationMemo; }
+
+	// Rank recommendations with another of SCORING_POLICIES; remembered lists
+	// were ranked by the old one and are dropped
+	bool setScoringPolicy(int policy)
+	{
+		if (policy < 0 || policy >= SCORING_POLICY_COUNT)
+		{
+			return false;
+		}
+		if (policy != scoringPolicy)
+		{
+			scoringPolicy = policy;
+			recommendationMemo.clear();
+		}
+		return true;
+	}
+
+	int currentScoringPolicy() const { return scoringPolicy; }
+
+	const vector<CarRecommendation> &currentRecommendations() const { return recommendations; }
+
+	double calculateRecommendationScore(double price, int popularity, double budget)
+	{
+		return recommendationScore(price, popularity, budget);
+	}
+
+	// How well a car suits a customer: the car's recommendation score for that
+	// budget, weighted by how much of the budget the car uses (price / budget)
+	double customerMatchScore(double price, int popularity, double budget)
+	{
+		if (budget <= 0.0)
+		{
+			return 0.0;
+		}
+		return (price / budget) * calculateRecommendationScore(price, popularity, budget);
+	}
+
+	// Top-K customers who can afford a car, best match first, as (customerID, score).
+	// The recommendation score is linear in price / budget, so the match score is
+	// a downward parabola in that ratio; its peak is located from two samples of
+	// calculateRecommendationScore and the budget index is walked outward from there.
+	vector<pair<int, double>> customersForCar(int carID, size_t k = 5)
+	{
+		int row = inventory.rowOf(carID);
+		if (row == -1 || k == 0)
+		{
+			return vector<pair<int, double>>();
+		}
+		double price = inventory.prices[row];
+		int popularity = inventory.popularity[row];
+
+		// score(ratio) = slope * (1 - ratio) + base, sampled at ratio 1 and 1/2
+		double base = calculateRecommendationScore(price, popularity, price);
+		double slope = 2.0 * (calculateRecommendationScore(price, popularity, price * 2.0) - base);
+		double peakRatio = slope > 0.0 ? min(1.0, (slope + base) / (2.0 * slope)) : 1.0;
+		double peakBudget = peakRatio > 0.0 ? price / peakRatio : price;
+
+		return customerBudgets.bestAround(peakBudget, price, k, [&](double budget)
+										  { return customerMatchScore(price, popularity, budget); });
+	}
+
+	void displayCustomersForCar(int carID, size_t k = 5)
+	{
+		CarNode car(0, 0, 0, 0.0);
+		if (!findCar(carID, car))
+		{
+			cout << "\nCar ID " << carID << " is not in the inventory." << endl;
+			return;
+		}
+
+		cout << "\n=== Best Customers for " << car.brand() << " " << car.model()
+			 << " ($" << car.price << ") ===" << endl;
+		vector<pair<int, double>> matches = customersForCar(carID, k);
+		for (const pair<int, double> &match : matches)
+		{
+			Customer *c = customerRecords.find(match.first);
+			cout << "ID: " << c->customerID
+				 << " | Name: " << c->name
+				 << " | Phone: " << c->phone
+				 << " | Budget: $" << c->budget
+				 << " | Match: " << match.second << endl;
+		}
+		if (matches.empty())
+		{
+			cout << "No customer can afford this car." << endl;
+		}
+	}
+
+	void displayRecommendations()
+	{
+		cout << "\n=== Car Recommendations (Top " << RECOMMENDATION_COUNT << ", "
+			 << SCORING_POLICIES[scoringPolicy].name << ") ===" << endl;
+		for (const CarRecommendation &rec : recommendations)
+		{
+			int row = inventory.rowOf(rec.carID);
+			if (row == -1) // Car was removed after recommendations were generated
+			{
+				continue;
+			}
+			cout << "Recommended: " << nameDictionary.nameOf(inventory.brandIDs[row])
+				 << " " << nameDictionary.nameOf(inventory.modelIDs[row])
+				 << " | Price: $" << inventory.prices[row]
+				 << " | Score: " << rec.score << endl;
+		}
+	}
+
+	// 8. KD-Tree Operations - Similar Cars
+	SimilarCarFeatures similarFeatures(int row) const
+	{
+		return SimilarCarFeatures(inventory.prices[row], inventory.popularity[row], inventory.brandIDs[row], inventory.bodyTypeIDs[row]);
+	}
+
+	// Available cars most like the given one (which may itself be sold), nearest
+	// first, as (carID, distance)
+	vector<pair<int, double>> similarCarsTo(int carID, size_t k = RECOMMENDATION_COUNT) const
+	{
+		int row = inventory.rowOf(carID);
+		if (row == -1)
+		{
+			return vector<pair<int, double>>();
+		}
+		return similarCars.nearest(similarFeatures(row), k, carID, [this](int candidate)
+								   { return inventory.available[inventory.rowOf(candidate)] != 0; });
+	}
+
+	void displaySimilarCars(int carID, size_t k = RECOMMENDATION_COUNT)
+	{
+		int row = inventory.rowOf(carID);
+		if (row == -1)
+		{
+			cout << "\nCar ID " << carID << " is not in the inventory." << endl;
+			return;
+		}
+
+		auto start = chrono::steady_clock::now();
+		vector<pair<int, double>> matches = similarCarsTo(carID, k);
+		double micros = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+		cout << "\n=== Cars Like " << nameDictionary.nameOf(inventory.brandIDs[row]) << " "
+			 << nameDictionary.nameOf(inventory.modelIDs[row]) << " ($" << inventory.prices[row] << ", "
+			 << nameDictionary.nameOf(inventory.bodyTypeIDs[row]) << ") ===" << endl;
+		for (const pair<int, double> &match : matches)
+		{
+			int other = inventory.rowOf(match.first);
+			cout << "ID: " << match.first
+				 << " | " << nameDictionary.nameOf(inventory.brandIDs[other])
+				 << " " << nameDictionary.nameOf(inventory.modelIDs[other])
+				 << " | " << nameDictionary.nameOf(inventory.bodyTypeIDs[other])
+				 << " | Price: $" << inventory.prices[other]
+				 << " | Popularity: " << inventory.popularity[other]
+				 << " | Distance: " << match.second << endl;
+		}
+		if (matches.empty())
+		{
+			cout << "No similar cars are available." << endl;
+		}
+		cout << "Found in " << micros << " us" << endl;
+	}
+
+	void addSampleData()
+	{
+		// Add sample cars
+		addCarToInventory("Toyota", "Camry", 25000, 8, 22000, "Sedan");
+		addCarToInventory("Honda", "Civic", 22000, 9, 19500, "Sedan");
+		addCarToInventory("BMW", "X5", 55000, 6, 45000, "SUV");
+		addCarToInventory("Mercedes", "C-Class", 45000, 7, 37500, "Sedan");
+		addCarToInventory("Ford", "Focus", 18000, 5, 16500, "Hatchback");
+
+		// Add sample customers
+		registerCustomer("John Doe", "123-456-7890", "john@email.com", 30000);
+		registerCustomer("Jane Smith", "098-765-4321", "jane@email.com", 50000);
+		registerCustomer("Bob Johnson", "555-123-4567", "bob@email.com", 20000);
+
+		// Add sample test drive requests
+		requestTestDrive(1, 1);
+		requestTestDrive(2, 3);
+
+		cout << "Sample data added successfully!" << endl;
+	}
+
+	// Load existing car data from files
+	void loadExistingCarData()
+	{
+		ifstream carsNameFile("Text Files/Cars_Name.txt");
+		ifstream carsPriceFile("Text Files/Cars_Price.txt");
+
+		string carName;
+		int carPrice;
+		int unknownBrandID = nameDictionary.intern("Unknown");
+
+		// Read cars from existing files and add to our data structures
+		while (carsNameFile >> carName && carsPriceFile >> carPrice)
+		{
+			// Extract brand and model (assuming format like "Toyota_Camry")
+			size_t underscorePos = carName.find('_');
+			int brandID = unknownBrandID;
+			int modelID = 0;
+
+			if (underscorePos != string::npos)
+			{
+				brandID = nameDictionary.intern(carName.substr(0, underscorePos));
+				modelID = nameDictionary.intern(carName.substr(underscorePos + 1));
+			}
+			else
+			{
+				modelID = nameDictionary.intern(carName);
+			}
+
+			addCarToInventory(brandID, modelID, carPrice, rand() % 10);
+		}
+
+		carsNameFile.close();
+		carsPriceFile.close();
+
+		cout << "Existing car data loaded into data structures!" << endl;
+	}
+};
+
+// Global instance of the dealership system
+CarDealershipSystem *dealershipSystem = nullptr;
+
+// Compare lookup and iteration speed of CustomerTable against unordered_map
+void benchmarkCustomerTable(int customerCount)
+{
+	// Same pseudo-random lookup sequence for both containers
+	const int lookups = 10000000;
+	vector<int> probeIDs(lookups);
+	unsigned int seed = 12345;
+	for (int i = 0; i < lookups; i++)
+	{
+		seed = seed * 1103515245u + 12345u;
+		probeIDs[i] = 1 + (int)(seed % (unsigned int)customerCount);
+	}
+
+	double mapBuildMs, mapLookupMs, mapIterateMs, checksum = 0.0;
+	{
+		unordered_map<int, Customer> customerMap;
+		auto start = chrono::steady_clock::now();
+		for (int id = 1; id <= customerCount; id++)
+		{
+			customerMap[id] = Customer(id, "", "", "", id % 100000);
+		}
+		auto built = chrono::steady_clock::now();
+		for (int id : probeIDs)
+		{
+			checksum += customerMap.find(id)->second.budget;
+		}
+		auto looked = chrono::steady_clock::now();
+		for (auto &pair : customerMap)
+		{
+			checksum += pair.second.budget;
+		}
+		auto iterated = chrono::steady_clock::now();
+		mapBuildMs = chrono::duration<double, milli>(built - start).count();
+		mapLookupMs = chrono::duration<double, milli>(looked - built).count();
+		mapIterateMs = chrono::duration<double, milli>(iterated - looked).count();
+	}
+
+	double tableBuildMs, tableLookupMs, tableIterateMs;
+	{
+		CustomerTable customerTable;
+		auto start = chrono::steady_clock::now();
+		for (int id = 1; id <= customerCount; id++)
+		{
+			customerTable.put(Customer(id, "", "", "", id % 100000));
+		}
+		auto built = chrono::steady_clock::now();
+		for (int id : probeIDs)
+		{
+			checksum -= customerTable.find(id)->budget;
+		}
+		auto looked = chrono::steady_clock::now();
+		for (Customer &c : customerTable)
+		{
+			checksum -= c.budget;
+		}
+		auto iterated = chrono::steady_clock::now();
+		tableBuildMs = chrono::duration<double, milli>(built - start).count();
+		tableLookupMs = chrono::duration<double, milli>(looked - built).count();
+		tableIterateMs = chrono::duration<double, milli>(iterated - looked).count();
+	}
+
+	cout << "\n=== Customer Store Benchmark (" << customerCount << " customers, " << lookups << " lookups) ===" << endl;
+	cout << fixed << setprecision(1);
+	cout << "unordered_map  build: " << mapBuildMs << " ms | lookup: " << mapLookupMs * 1e6 / lookups
+		 << " ns/op | iterate: " << mapIterateMs << " ms" << endl;
+	cout << "CustomerTable  build: " << tableBuildMs << " ms | lookup: " << tableLookupMs * 1e6 / lookups
+		 << " ns/op | iterate: " << tableIterateMs << " ms" << endl;
+	cout << "Checksum (should be 0): " << checksum << endl;
+	cout.unsetf(ios::fixed);
+	cout << setprecision(6);
+}
+
+// Pseudo-random catalog for the recommendation benchmarks: prices $5k-$100k,
+// popularity 0-10, cost 75-95% of price, added within the last year, one car
+// in sixteen already sold
+InventoryStore syntheticCatalog(int carCount)
+{
+	InventoryStore catalog;
+	Timestamp now = currentTimestamp();
+	unsigned int seed = 12345;
+	for (int id = 1; id <= carCount; id++)
+	{
+		seed = seed * 1103515245u + 12345u;
+		double price = 5000.0 + (seed >> 8) % 95000;
+		catalog.addCar(id, 0, 0, price, (seed & 15) != 0, (int)((seed >> 4) % 11),
+					   price * (0.75 + (seed % 21) / 100.0), now - (Timestamp)(seed % (365 * 86400)), 0);
+	}
+	return catalog;
+}
+
+// Recommendation latency over a synthetic catalog: the scalar kernel against
+// each SIMD kernel this CPU supports, with a check that the picked scores agree
+// (to rounding; equal-scoring cars may be ordered differently)
+void benchmarkRecommendationScoring(int carCount)
+{
+	const int queries = 50;
+	InventoryStore catalog = syntheticCatalog(carCount);
+
+	vector<RecommendationKernelChoice> kernels;
+	kernels.push_back(RecommendationKernelChoice{scoreRecommendationsScalar, "Scalar"});
+#ifdef RECOMMENDATION_SIMD
+	kernels.push_back(RecommendationKernelChoice{scoreRecommendationsSse2, "SSE2"});
+	if (cpuHasAvx2())
+	{
+		kernels.push_back(RecommendationKernelChoice{scoreRecommendationsAvx2, "AVX2"});
+	}
+#endif
+
+	cout << "\n=== Recommendation Scoring Benchmark (" << carCount << " cars, " << queries << " budgets) ===" << endl;
+	cout << "Dispatched kernel: " << recommendationKernel().name << endl;
+	cout << fixed << setprecision(3);
+	vector<vector<CarRecommendation>> reference;
+	double scalarMs = 0.0;
+	for (const RecommendationKernelChoice &choice : kernels)
+	{
+		int mismatches = 0;
+		auto start = chrono::steady_clock::now();
+		for (int q = 0; q < queries; q++)
+		{
+			double budget = 10000.0 + q * 1800.0;
+			vector<CarRecommendation> picks = topRecommendations(catalog, budget, RECOMMENDATION_COUNT, choice.kernel);
+			if (reference.size() < (size_t)queries)
+			{
+				reference.push_back(picks);
+				continue;
+			}
+			for (size_t i = 0; i < picks.size() || i < reference[q].size(); i++)
+			{
+				if (i >= picks.size() || i >= reference[q].size() || fabs(picks[i].score - reference[q][i].score) > 1e-12)
+				{
+					mismatches++;
+					break;
+				}
+			}
+		}
+		double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() / queries;
+		if (scalarMs == 0.0)
+		{
+			scalarMs = ms;
+		}
+		cout << choice.name << "\t" << ms << " ms/query | speedup: " << scalarMs / ms
+			 << "x | mismatches vs scalar: " << mismatches << endl;
 	}
+	cout.unsetf(ios::fixed);
+	cout << setprecision(6);
+}
 
-	void addSampleData()
+// Batch recommendation throughput with 1, 2, 4, ... threads up to every core,
+// checked against the single-threaded lists
+void benchmarkBatchRecommendations(int carCount, int budgetCount)
+{
+	InventoryStore catalog = syntheticCatalog(carCount);
+	vector<double> budgets(budgetCount);
+	unsigned int seed = 54321;
+	for (double &budget : budgets)
 	{
-		// Add sample cars
-		addCarToInventory("Toyota", "Camry", 25000, 8);
-		addCarToInventory("Honda", "Civic", 22000, 9);
-		addCarToInventory("BMW", "X5", 55000, 6);
-		addCarToInventory("Mercedes", "C-Class", 45000, 7);
-		addCarToInventory("Ford", "Focus", 18000, 5);
-
-		// Add sample customers
-		registerCustomer("John Doe", "123-456-7890", "john@email.com", 30000);
-		registerCustomer("Jane Smith", "098-765-4321", "jane@email.com", 50000);
-		registerCustomer("Bob Johnson", "555-123-4567", "bob@email.com", 20000);
+		seed = seed * 1103515245u + 12345u;
+		budget = 8000.0 + (seed >> 8) % 120000;
+	}
 
-		// Add sample test drive requests
-		requestTestDrive(1, 1);
-		requestTestDrive(2, 3);
+	RecommendationKernel kernel = recommendationKernel().kernel;
+	int cores = defaultWorkerThreads();
+	cout << "\n=== Batch Recommendation Benchmark (" << carCount << " cars, " << budgetCount << " budgets, "
+		 << cores << " cores, " << recommendationKernel().name << ") ===" << endl;
+	cout << fixed << setprecision(1);
+	vector<vector<CarRecommendation>> reference;
+	double singleMs = 0.0;
+	for (int threads = 1;; threads = min(threads * 2, cores))
+	{
+		auto start = chrono::steady_clock::now();
+		vector<vector<CarRecommendation>> lists = batchRecommendations(catalog, budgets, RECOMMENDATION_COUNT, threads, kernel);
+		double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
 
-		cout << "Sample data added successfully!" << endl;
+		int mismatches = 0;
+		if (reference.empty())
+		{
+			reference.swap(lists);
+			singleMs = ms;
+		}
+		else
+		{
+			for (size_t i = 0; i < lists.size(); i++)
+			{
+				mismatches += lists[i].size() != reference[i].size() ||
+							  !equal(lists[i].begin(), lists[i].end(), reference[i].begin(),
+									 [](const CarRecommendation &a, const CarRecommendation &b)
+									 { return a.carID == b.carID && a.score == b.score; });
+			}
+		}
+		cout << threads << " thread(s): " << ms << " ms | " << budgetCount * 1000.0 / ms << " lists/s | speedup: "
+			 << setprecision(2) << singleMs / ms << "x | efficiency: " << singleMs / ms / threads * 100.0
+			 << "% | mismatches: " << mismatches << setprecision(1) << endl;
+		if (threads == cores)
+		{
+			break;
+		}
 	}
+	cout.unsetf(ios::fixed);
+	cout << setprecision(6);
+}
 
-	// Load existing car data from files
-	void loadExistingCarData()
-	{
-		ifstream carsNameFile("Text Files/Cars_Name.txt");
-		ifstream carsPriceFile("Text Files/Cars_Price.txt");
+// Throughput of test drive intake with 1..maxProducers producer threads and
+// one consumer draining up to TEST_DRIVE_DRAIN_BATCH requests per call:
+// lock-free ring vs. a mutex-guarded std::queue (one lock per drained batch)
+void benchmarkTestDriveIntake(int maxProducers)
+{
+	const int requests = 2000000;
 
-		string carName;
-		int carPrice;
+	cout << "\n=== Test Drive Intake Benchmark (" << requests << " requests per run) ===" << endl;
+	cout << fixed << setprecision(1);
+	for (int producers = 1; producers <= maxProducers; producers *= 2)
+	{
+		int perProducer = requests / producers;
+		int total = perProducer * producers;
 
-		// Read cars from existing files and add to our data structures
-		while (carsNameFile >> carName && carsPriceFile >> carPrice)
+		// Lock-free ring, consumer drains in batches
+		double ringMs;
 		{
-			// Extract brand and model (assuming format like "Toyota_Camry")
-			size_t underscorePos = carName.find('_');
-			string brand = "Unknown";
-			string model = carName;
-
-			if (underscorePos != string::npos)
+			MpmcRing<TestDriveRequest> ring(TEST_DRIVE_INTAKE_CAPACITY);
+			auto start = chrono::steady_clock::now();
+			vector<thread> threads;
+			for (int p = 0; p < producers; p++)
+			{
+				threads.emplace_back([&ring, p, perProducer]()
+				{
+					TestDriveRequest request(p, 0, 0, 0);
+					for (int i = 0; i < perProducer; i++)
+					{
+						request.carID = i;
+						while (!ring.tryEnqueue(request))
+							this_thread::yield();
+					}
+				});
+			}
+			TestDriveRequest batch[TEST_DRIVE_DRAIN_BATCH];
+			for (int consumed = 0; consumed < total;)
 			{
-				brand = carName.substr(0, underscorePos);
-				model = carName.substr(underscorePos + 1);
+				size_t taken = ring.tryDequeueBulk(batch, TEST_DRIVE_DRAIN_BATCH);
+				if (taken == 0)
+					this_thread::yield();
+				consumed += (int)taken;
 			}
+			for (thread &t : threads)
+				t.join();
+			ringMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+		}
 
-			addCarToInventory(brand, model, carPrice, rand() % 10);
+		// std::queue behind a mutex, consumer drains a batch per lock
+		double lockedMs;
+		{
+			queue<TestDriveRequest> locked;
+			mutex lock;
+			auto start = chrono::steady_clock::now();
+			vector<thread> threads;
+			for (int p = 0; p < producers; p++)
+			{
+				threads.emplace_back([&locked, &lock, p, perProducer]()
+				{
+					TestDriveRequest request(p, 0, 0, 0);
+					for (int i = 0; i < perProducer; i++)
+					{
+						request.carID = i;
+						lock_guard<mutex> guard(lock);
+						locked.push(request);
+					}
+				});
+			}
+			TestDriveRequest batch[TEST_DRIVE_DRAIN_BATCH];
+			for (int consumed = 0; consumed < total;)
+			{
+				size_t taken = 0;
+				{
+					lock_guard<mutex> guard(lock);
+					for (; taken < TEST_DRIVE_DRAIN_BATCH && !locked.empty(); taken++)
+					{
+						batch[taken] = locked.front();
+						locked.pop();
+					}
+				}
+				if (taken == 0)
+					this_thread::yield();
+				consumed += (int)taken;
+			}
+			for (thread &t : threads)
+				t.join();
+			lockedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
 		}
 
-		carsNameFile.close();
-		carsPriceFile.close();
+		cout << setw(2) << producers << " producers | lock-free ring: " << setw(6) << total / ringMs / 1000.0
+			 << " M req/s | mutex queue: " << setw(6) << total / lockedMs / 1000.0 << " M req/s" << endl;
+	}
+	cout << "Hardware threads: " << thread::hardware_concurrency() << endl;
+	cout.unsetf(ios::fixed);
+	cout << setprecision(6);
+}
 
-		cout << "Existing car data loaded into data structures!" << endl;
+// Regression checks for the deal workflow. On a cycle that skips the entry
+// department (Sales -> Finance -> Service -> Finance) every simulated
+// customer and every deal must leave after one visit to each department;
+// a cancelled deal that is reopened must queue behind the deals already
+// waiting. Returns the number of failed checks.
+int testDealWorkflow()
+{
+	WorkflowGraph graph;
+	graph.addEdge("Sales", "Finance");
+	graph.addEdge("Finance", "Service");
+	graph.addEdge("Service", "Finance");
+	int failures = 0;
+	auto check = [&failures](bool passed, const string &what)
+	{
+		cout << (passed ? "PASS  " : "FAIL  ") << what << endl;
+		failures += !passed;
+	};
+
+	cout << "\n=== Workflow Regression Tests ===" << endl;
+	SimulationConfig config;
+	config.entryDept = config.testDriveDept = graph.idOf("Sales");
+	config.days = 7;
+	config.salesPerDay = 20.0;
+	config.testDrivesPerDay = 0.0;
+	SimulationResult result = WorkflowSimulator(graph, config).run();
+	int customers = result.departments.empty() ? -1 : result.departments[config.entryDept].arrivals;
+	check(customers > 0 && result.customers == customers, "simulator: every sale customer leaves");
+	bool onceEach = !result.departments.empty();
+	for (const SimulationDeptResult &dept : result.departments)
+	{
+		onceEach = onceEach && dept.served == customers;
 	}
-};
+	check(onceEach, "simulator: each department serves each customer once");
 
-// Global instance of the dealership system
-CarDealershipSystem *dealershipSystem = nullptr;
+	DealTracker tracker;
+	tracker.reset(graph.size());
+	tracker.open(1, graph.idOf("Sales"), 0);
+	int finishes = 0;
+	for (int step = 0; step < 3 * graph.size() && tracker.openDeals() > 0; step++)
+	{
+		for (int dept = 0; dept < graph.size(); dept++)
+		{
+			int dealID;
+			if (tracker.startNext(dept, step, dealID) && tracker.finish(dealID, graph, step + 1))
+				finishes++;
+		}
+	}
+	check(tracker.closedDeals() == 1 && finishes == graph.size(), "deal tracker: deal closes after one pass");
+
+	// Cancel (sale undone) then reopen (sale redone) while others wait
+	int sales = graph.idOf("Sales"), finance = graph.idOf("Finance"), started = 0;
+	DealTracker queued;
+	queued.reset(graph.size());
+	for (int id = 1; id <= 3; id++)
+		queued.open(id, sales, id);
+	queued.cancel(1);
+	queued.reopen(1, sales, 10);
+	check(queued.startNext(sales, 11, started) && started == 2, "deal tracker: reopened deal queues at the back");
+
+	// Cancelled while waiting in Finance, back in Finance after a later deal
+	DealTracker rejoined;
+	rejoined.reset(graph.size());
+	auto passSales = [&](int id, Timestamp now)
+	{
+		rejoined.open(id, sales, now);
+		rejoined.startNext(sales, now, started);
+		rejoined.finish(id, graph, now);
+	};
+	passSales(1, 1); // 1 waits in Finance
+	rejoined.cancel(1);
+	passSales(2, 2); // 2 waits in Finance
+	rejoined.reopen(1, sales, 3);
+	rejoined.startNext(sales, 3, started);
+	rejoined.finish(1, graph, 3); // 1 waits in Finance again, behind 2
+	vector<int> order;
+	while (rejoined.startNext(finance, 4, started))
+		order.push_back(started);
+	check(order == vector<int>({2, 1}), "deal tracker: re-entering a department keeps FIFO order");
+	return failures;
+}
 
 // Loading function with proper console encoding and characters
 void loading()
@@ -1121,7 +6248,7 @@ public:
 class BackEnd
 {
 public:
-	void display_menu(const string &manufacturer, const string names[], const int prices[], const size_t numCars)
+	void display_menu(const string &manufacturer, const int nameIDs[], const int prices[], const size_t numCars)
 	{
 		// Text COLOR settings
 		HANDLE Display_Menu_Color = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -1137,7 +6264,7 @@ public:
 			SetConsoleTextAttribute(Display_Menu_Color, 10);
 			cout << "]\t";
 			SetConsoleTextAttribute(Display_Menu_Color, 9);
-			cout << names[i];
+			cout << nameDictionary.nameOf(nameIDs[i]);
 			SetConsoleTextAttribute(Display_Menu_Color, 11);
 			cout << "\tfor ";
 			SetConsoleTextAttribute(Display_Menu_Color, 9);
@@ -1155,7 +6282,7 @@ public:
 		}
 	}
 
-	void display_color(const string color_index[], const size_t numColors)
+	void display_color(const int colorIDs[], const size_t numColors)
 	{
 		// Text COLOR settings
 		HANDLE Display_Color_Color = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -1169,7 +6296,7 @@ public:
 			SetConsoleTextAttribute(Display_Color_Color, 10);
 			cout << "] ";
 			SetConsoleTextAttribute(Display_Color_Color, 11);
-			cout << color_index[a];
+			cout << nameDictionary.nameOf(colorIDs[a]);
 			cout << endl;
 		}
 	}
@@ -1305,13 +6432,8 @@ public:
 		// Text COLOR settings
 		HANDLE OrderLogsColor = GetStdHandle(STD_OUTPUT_HANDLE);
 
-		ifstream Order_Logs("Text Files/Order_Logs.txt");
-
-		string date;
-		string time;
-		string car_name;
-		string car_color;
-		int car_price;
+		// One row per sale in effect in the sales journal
+		vector<SalesJournalRecord> orders = dealershipSystem->orderLog();
 
 		SetConsoleTextAttribute(OrderLogsColor, 8);
 		cout << "\n+------------+----------+--------------+------------+----------------+" << endl;
@@ -1338,8 +6460,16 @@ public:
 		cout << "|" << endl;
 		cout << "+------------+----------+--------------+------------+----------------+" << endl;
 
-		while (Order_Logs >> date >> time >> car_name >> car_color >> car_price)
+		for (size_t i = 0; i < orders.size(); i++)
 		{
+			string stamp = logTimeFormatter.format(orders[i].time);
+			size_t tab = stamp.find('\t');
+			string date = stamp.substr(0, tab);
+			string time = tab == string::npos ? "" : stamp.substr(tab + 1);
+			string car_name = orders[i].model;
+			string car_color = orders[i].color;
+			long long car_price = (long long)orders[i].amount;
+
 			SetConsoleTextAttribute(OrderLogsColor, 8);
 			cout << "|";
 			SetConsoleTextAttribute(OrderLogsColor, 9);
@@ -1713,6 +6843,13 @@ int main()
 	// Add some sample data for demonstration
 	dealershipSystem->addSampleData();
 
+	// Replay past sales so sold cars stay sold across restarts; on the first
+	// run, carry the orders already in the text order log into the journal
+	if (dealershipSystem->openSalesJournal("Text Files/Sales_Journal.bin") == 0)
+	{
+		dealershipSystem->importOrderLog("Text Files/Order_Logs.txt");
+	}
+
 	// Create instances of classes for different functionalities
 	DetailClass AboutUs;	 // For displaying about us information
 	DetailClass TitleScreen; // For displaying title screen
@@ -1780,6 +6917,7 @@ int main()
 	// Sub-menu choice variables
 	int employeeData; // Employee data management choice
 	int CarChoice;	  // Car data management choice
+	int toolsChoice;  // System tools choice
 
 	// Show loading bar only before main menu
 	system("CLS");					// Clear the screen
@@ -2007,12 +7145,7 @@ int main()
 			if (adminlogin == 1)
 			{
 				// Record login activity in log file
-				auto t = time(nullptr);	  // Get current time
-				auto tm = *localtime(&t); // Convert to local time
-
-				ostringstream oss;							// String stream for formatting
-				oss << put_time(&tm, "%b/%d/%Y\t%H:%M:%S"); // Format date and time
-				auto str = oss.str();						// Convert to string
+				const string &str = logTimeFormatter.format(currentTimestamp()); // Current time as log text
 
 				// Write login log entry
 				ofstream Login_Logs("Text Files/Login_Logs.txt", ios::app);
@@ -2035,11 +7168,12 @@ int main()
 				Choice.choiceBlue("2", "Cars Data");	 // Car data management in blue
 				Choice.choiceBlue("3", "Order Logs");	 // View order logs in blue
 				Choice.choiceBlue("4", "Login Logs");	 // View login logs in blue
-				Choice.choiceBlue("5", "Order Cars\n");	 // Order cars in blue
+				Choice.choiceBlue("5", "Order Cars");	 // Order cars in blue
+				Choice.choiceBlue("6", "System Tools\n"); // Data structure tools in blue
 
-				Choice.choiceGreen("6", "About Us"); // About us in green
+				Choice.choiceGreen("7", "About Us"); // About us in green
 
-				Choice.choiceRed("7", "Logout\n"); // Logout in red
+				Choice.choiceRed("8", "Logout\n"); // Logout in red
 
 				// Prompt for admin menu choice
 				FontTextColor.fontTextColor(9);			   // Set text color to blue
@@ -3795,33 +8929,204 @@ int main()
 							}
 						} while (c_Color != 13);
 
-						if (addcolorHider.length() == 0)
-						{
-							system("CLS");
-							system("a 4f");
-							cout << "\n   Please enter the name of the car!" << endl;
-							cout << endl;
-							cout << "   ";
-							system("PAUSE");
-							goto AddCarsNamePrice;
-						}
+						if (addcolorHider.length() == 0)
+						{
+							system("CLS");
+							system("a 4f");
+							cout << "\n   Please enter the name of the car!" << endl;
+							cout << endl;
+							cout << "   ";
+							system("PAUSE");
+							goto AddCarsNamePrice;
+						}
+
+						else
+						{
+							addcolor = addcolorHider;
+						}
+
+						FontTextColor.fontTextColor(1);
+						ofstream Cars_Color("Text Files/Cars_Color.txt", ios::app);
+						Cars_Color << addcolor << endl;
+						cout << "\n   Car Color Added!" << endl;
+						cout << "   ";
+						goto CarData;
+					}
+
+					// Edit Cars Color
+					else if (CarChoice == 7)
+					{
+						// Loading screen
+						system("CLS");
+						system("COLOR 0F");
+						char a = 219;
+						Coordinate.gotoxy(30, 10);
+						cout << "[Loading]" << endl;
+						Coordinate.gotoxy(25, 12);
+						for (int r = 1; r <= 20; r++)
+						{
+							for (int q = 0; q <= 10000000; q++)
+								;
+							cout << a;
+						}
+						cout << endl
+							 << endl
+							 << endl
+							 << endl
+							 << endl
+							 << endl
+							 << endl;
+
+						// system title
+						system("TITLE Car Dealership Management Program [Edit Cars Color]");
+
+						TitleText.titleText("                          Edit Car Color                        ");
+
+						ViewCarData.viewCarColor();
+
+						Choice.choiceBack("0", "Back");
+
+						cout << endl;
+						FontTextColor.fontTextColor(9);
+						cout << "   Type the number of line to edit";
+
+						// deletion per line
+
+						// variables for storing the filename of the file and the line number to
+						// delete in the file
+						int line_number;
+						string strColor;
+
+						// Prompt the user to enter the line number to delete in the file, store it
+						// into line_number
+
+						cout << endl;
+						cout << "   Line: ";
+						FontTextColor.fontTextColor(11);
+
+						cin >> line_number;
+
+						if (line_number == 0)
+						{
+							cin.clear();
+							cin.ignore(22, '\n');
+							system("CLS");
+
+							goto CarData;
+						}
+
+						// fstream object will be used to read all of the existing lines in the file
+						fstream read_file;
+
+						// Open the file with the provided filename
+						read_file.open("Text Files/Cars_Color.txt");
+
+						// If file failed to open, exit with an error message and error exit status
+						if (read_file.fail())
+						{
+							system("COLOR 4F");
+							cout << endl;
+							cout << "   Error opening file." << endl;
+
+							Sleep(3000);
+							goto DeleteCarsColor;
+							// returning 1 instead of 0 is a signal to the shell that something went
+							// wrong in the execution of the program
+						}
+
+						// Create a vector to store all the file lines, and a string line to store
+						// each line that we read
+						vector<string> lines;
+						string line;
+
+						// Read each line of the file and store it as the next element of the vector,
+						// the loop will stop when there are no more lines to read
+						while (getline(read_file, line))
+							lines.push_back(line);
+
+						// Close our access to the file since we are done reading with it
+						read_file.close();
+
+						// The vector will now contain an element for each line in the file, so the
+						// size of the vector is the number of lines in the file.  Check to make
+						// sure the line number requested does not exceed the number of lines in
+						// the file, if it does, exit with an error message and status.
+						if (line_number > lines.size())
+						{
+							cout << endl;
+							cout << "   Line " << line_number;
+							cout << " not in file." << endl;
+
+							// Inform user how many lines ARE in the file as part of the error message
+							cout << "   File has " << lines.size();
+							cout << " lines." << endl;
+
+							Sleep(3000);
+							goto DeleteCarsColor;
+						}
+
+						// Create ofstream object for writing to the file
+						ofstream write_file;
+
+						// Open the file with the provided filename
+						write_file.open("Text Files/Cars_Color.txt");
+
+						// If the file failed to open, exit with an error message and exit status
+						if (write_file.fail())
+						{
+							system("COLOR 4F");
+
+							cout << endl;
+							cout << "   Error opening file." << endl;
+
+							Sleep(3000);
+							goto DeleteCarsColor;
+						}
+
+						// Write all of the lines stored in the vector back to the file, EXCEPT the
+						// line that we want to delete.
+
+						// Line number 1 will be stored at vector index 0, line number 2 will be
+						// stored at vector index 1, and so on because vectors are zero-indexed, so
+						// decrement line_number to help us identify when we've reached the
+						// associated line in the file.
+						line_number--;
+
+						// Loop through the vector elements to write each line back to the file
+						// EXCEPT the line we want to delete.
+						for (int i = 0; i < lines.size(); i++)
+							if (i != line_number)
+								write_file << lines[i] << endl;
+
+						// Close our access to the file since we are done working with it
+						write_file.close();
 
-						else
-						{
-							addcolor = addcolorHider;
-						}
+						// Add COLOR to text file
 
+						cout << endl;
+						FontTextColor.fontTextColor(9);
+						cout << "   Enter the Color: ";
+						FontTextColor.fontTextColor(11);
+						cin >> strColor;
 						FontTextColor.fontTextColor(1);
-						ofstream Cars_Color("Text Files/Cars_Color.txt", ios::app);
-						Cars_Color << addcolor << endl;
-						cout << "\n   Car Color Added!" << endl;
+
+						ofstream addcolor("Text Files/Cars_Color.txt", ios::app);
+						addcolor << endl
+								 << strColor;
+
+						cout << endl;
+						cout << "   Line " << line_number + 1 << " has been editted!";
+						cout << endl;
 						cout << "   ";
+
+						system("PAUSE");
 						goto CarData;
 					}
 
-					// Edit Cars Color
-					else if (CarChoice == 7)
+					// Delete Cars Color
+					else if (CarChoice == 8)
 					{
+					DeleteCarsColor:
 						// Loading screen
 						system("CLS");
 						system("COLOR 0F");
@@ -3844,9 +9149,9 @@ int main()
 							 << endl;
 
 						// system title
-						system("TITLE Car Dealership Management Program [Edit Cars Color]");
+						system("TITLE Car Dealership Management Program [Delete Cars Color]");
 
-						TitleText.titleText("                          Edit Car Color                        ");
+						TitleText.titleText("                         Delete Car Color                       ");
 
 						ViewCarData.viewCarColor();
 
@@ -3854,14 +9159,13 @@ int main()
 
 						cout << endl;
 						FontTextColor.fontTextColor(9);
-						cout << "   Type the number of line to edit";
+						cout << "   Type the number of line to delete";
 
 						// deletion per line
 
 						// variables for storing the filename of the file and the line number to
 						// delete in the file
 						int line_number;
-						string strColor;
 
 						// Prompt the user to enter the line number to delete in the file, store it
 						// into line_number
@@ -3967,197 +9271,560 @@ int main()
 						// Close our access to the file since we are done working with it
 						write_file.close();
 
-						// Add COLOR to text file
+						cout << endl;
+						cout << "   Line " << line_number + 1 << " has been deleted";
+						cout << endl;
+						cout << "   ";
+
+						system("PAUSE");
+						goto CarData;
+					}
+
+					// Back
+					else if (CarChoice == 9)
+					{
+						system("CLS");
+						goto AdminMenu;
+					}
 
+					else
+					{
+						// system title
+						system("TITLE Car Dealership Management Program [Error Cars Data]");
+
+						system("CLS");
+						system("COLOR 4F");
+						cout << "\n   Wrong input entered!" << endl;
+						cin.clear();
+						cin.ignore(22, '\n');
 						cout << endl;
+						cout << "   ";
+						system("PAUSE");
+						goto CarData;
+					}
+				}
+
+				// Order Logs
+				else if (adminchoice == 3)
+				{
+					// Set system title for order logs
+					system("TITLE Car Dealership Management Program [Order Logs]");
+
+					TitleText.titleText("                           Order Logs                           ");
+
+					OrderLogs.orderLogs();
+
+					FontTextColor.fontTextColor(11);
+					dealershipSystem->displaySalesRollups();
+
+					FontTextColor.fontTextColor(9);
+					cout << "\n   All Order Logs Data!";
+					cout << endl;
+					cout << "   ";
+					system("PAUSE");
+					goto AdminMenu;
+				}
+
+				// Login Logs
+				else if (adminchoice == 4)
+				{
+					// Set system title for login logs
+					system("TITLE Car Dealership Management Program [Login Logs]");
+
+					TitleText.titleText("                           Login Logs                           ");
+
+					LoginLogs.loginLogs();
+
+					FontTextColor.fontTextColor(9);
+					cout << "\n   All Login Logs Data!";
+					cout << endl;
+					cout << "   ";
+					system("PAUSE");
+					goto AdminMenu;
+				}
+
+				// Order Cars (Admin)
+				else if (adminchoice == 5)
+				{
+					AccessLevel = 1; // Set access level to admin
+
+					// Set system title for admin order cars
+					system("TITLE Car Dealership Management Program [Admin Order Cars]");
+
+					goto OrderCars; // Go to order cars section
+				}
+
+				// System Tools (Admin)
+				else if (adminchoice == 6)
+				{
+				SystemTools:
+
+					// Set system title for system tools
+					system("TITLE Car Dealership Management Program [System Tools]");
+
+					TitleText.titleText("                          System Tools                          ");
+
+					cout << endl;
+					Choice.choiceBlue("1", "Memory Statistics");
+					Choice.choiceBlue("2", "Price Statistics");
+					Choice.choiceBlue("3", "Customer Table Benchmark");
+					Choice.choiceBlue("4", "Customer Lookup (Phone / Email)");
+					Choice.choiceBlue("5", "Fuzzy Customer Name Search");
+					Choice.choiceBlue("6", "Customers for a Car");
+					Choice.choiceBlue("7", "Test Drive Intake Benchmark");
+					Choice.choiceBlue("8", "Undo / Redo Sales");
+					Choice.choiceBlue("9", "Showroom Workflow");
+					Choice.choiceBlue("10", "Deal Workflow Queues");
+					Choice.choiceBlue("11", "Workflow Capacity Simulator");
+					Choice.choiceBlue("12", "Recommendation Scoring Benchmark");
+					Choice.choiceBlue("13", "Export Customer Recommendation Lists");
+					Choice.choiceBlue("14", "Batch Recommendation Scaling Benchmark");
+					Choice.choiceBlue("15", "Recommendation Scoring Policy");
+					Choice.choiceBlue("16", "Similar Cars");
+					Choice.choiceBlue("17", "Workflow Regression Tests\n");
+
+					Choice.choiceRed("18", "Back\n");
+
+					FontTextColor.fontTextColor(9);
+					cout << "    Please insert your choice: ";
+
+					FontTextColor.fontTextColor(11);
+					cin >> toolsChoice;
+					cout << endl;
+					cin.ignore();
+
+					// Memory Statistics
+					if (toolsChoice == 1)
+					{
+						FontTextColor.fontTextColor(11);
+						dealershipSystem->displayMemoryStats();
+
 						FontTextColor.fontTextColor(9);
-						cout << "   Enter the Color: ";
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
+
+					// Price Statistics
+					else if (toolsChoice == 2)
+					{
 						FontTextColor.fontTextColor(11);
-						cin >> strColor;
-						FontTextColor.fontTextColor(1);
+						dealershipSystem->displayPriceStatistics();
 
-						ofstream addcolor("Text Files/Cars_Color.txt", ios::app);
-						addcolor << endl
-								 << strColor;
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
 
-						cout << endl;
-						cout << "   Line " << line_number + 1 << " has been editted!";
-						cout << endl;
-						cout << "   ";
+					// Customer Table Benchmark
+					else if (toolsChoice == 3)
+					{
+						int customerCount = 10000000;
+						FontTextColor.fontTextColor(9);
+						cout << "   Number of customers (e.g. 10000000): ";
+						FontTextColor.fontTextColor(11);
+						cin >> customerCount;
+						cin.ignore();
+
+						if (customerCount < 1)
+						{
+							customerCount = 10000000;
+						}
+						benchmarkCustomerTable(customerCount);
 
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
 						system("PAUSE");
-						goto CarData;
+						goto SystemTools;
 					}
 
-					// Delete Cars Color
-					else if (CarChoice == 8)
+					// Customer Lookup
+					else if (toolsChoice == 4)
 					{
-					DeleteCarsColor:
-						// Loading screen
-						system("CLS");
-						system("COLOR 0F");
-						char a = 219;
-						Coordinate.gotoxy(30, 10);
-						cout << "[Loading]" << endl;
-						Coordinate.gotoxy(25, 12);
-						for (int r = 1; r <= 20; r++)
+						string lookupQuery;
+						FontTextColor.fontTextColor(9);
+						cout << "   Phone number or email prefix: ";
+						FontTextColor.fontTextColor(11);
+						getline(cin, lookupQuery);
+
+						dealershipSystem->displayCustomerLookup(lookupQuery);
+
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
+
+					// Fuzzy Customer Name Search
+					else if (toolsChoice == 5)
+					{
+						string nameQuery;
+						FontTextColor.fontTextColor(9);
+						cout << "   Shows the 5 closest names; takes about 2 ms at 1M customers." << endl;
+						cout << "   Customer name (spelling may be approximate): ";
+						FontTextColor.fontTextColor(11);
+						getline(cin, nameQuery);
+
+						dealershipSystem->displayCustomerNameSearch(nameQuery);
+
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
+
+					// Customers for a Car
+					else if (toolsChoice == 6)
+					{
+						int matchCarID = 0;
+						FontTextColor.fontTextColor(9);
+						cout << "   Car ID: ";
+						FontTextColor.fontTextColor(11);
+						cin >> matchCarID;
+						cin.ignore();
+
+						dealershipSystem->displayCustomersForCar(matchCarID);
+
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
+
+					// Test Drive Intake Benchmark
+					else if (toolsChoice == 7)
+					{
+						int maxProducers = 32;
+						FontTextColor.fontTextColor(9);
+						cout << "   Maximum producer threads (e.g. 32): ";
+						FontTextColor.fontTextColor(11);
+						cin >> maxProducers;
+						cin.ignore();
+
+						if (maxProducers < 1)
 						{
-							for (int q = 0; q <= 10000000; q++)
-								;
-							cout << a;
+							maxProducers = 32;
 						}
-						cout << endl
-							 << endl
-							 << endl
-							 << endl
-							 << endl
-							 << endl
-							 << endl;
+						benchmarkTestDriveIntake(maxProducers);
 
-						// system title
-						system("TITLE Car Dealership Management Program [Delete Cars Color]");
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
 
-						TitleText.titleText("                         Delete Car Color                       ");
+					// Undo / Redo Sales
+					else if (toolsChoice == 8)
+					{
+						int undoChoice = 0, undoValue = 0;
+						FontTextColor.fontTextColor(11);
+						dealershipSystem->displaySalesHistoryStatus();
+						FontTextColor.fontTextColor(9);
+						cout << "\n   1 = Undo last N sales, 2 = Undo sale by ID, 3 = Redo last N undone sales: ";
+						FontTextColor.fontTextColor(11);
+						cin >> undoChoice;
+						FontTextColor.fontTextColor(9);
+						cout << (undoChoice == 2 ? "   Sale ID: " : "   Number of sales: ");
+						FontTextColor.fontTextColor(11);
+						cin >> undoValue;
+						cin.ignore();
 
-						ViewCarData.viewCarColor();
+						if (undoChoice == 1 && undoValue > 0)
+						{
+							cout << "\n   Sales undone: " << dealershipSystem->undoLastSales(undoValue) << endl;
+						}
+						else if (undoChoice == 2)
+						{
+							cout << (dealershipSystem->undoSale(undoValue) ? "\n   Sale undone." : "\n   No such sale in effect.") << endl;
+						}
+						else if (undoChoice == 3 && undoValue > 0)
+						{
+							cout << "\n   Sales redone: " << dealershipSystem->redoSales(undoValue) << endl;
+						}
+						else
+						{
+							cin.clear();
+							cout << "\n   Wrong input entered!" << endl;
+						}
+
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
 
-						Choice.choiceBack("0", "Back");
+					// Showroom Workflow
+					else if (toolsChoice == 9)
+					{
+						string fromDept, toDept;
+						FontTextColor.fontTextColor(11);
+						dealershipSystem->displayWorkflow();
+						dealershipSystem->displayWorkflowCycle();
 
-						cout << endl;
 						FontTextColor.fontTextColor(9);
-						cout << "   Type the number of line to delete";
-
-						// deletion per line
+						cout << "\n   Path from department: ";
+						FontTextColor.fontTextColor(11);
+						getline(cin, fromDept);
+						FontTextColor.fontTextColor(9);
+						cout << "   Path to department: ";
+						FontTextColor.fontTextColor(11);
+						getline(cin, toDept);
 
-						// variables for storing the filename of the file and the line number to
-						// delete in the file
-						int line_number;
+						dealershipSystem->displayWorkflowPath(fromDept, toDept);
 
-						// Prompt the user to enter the line number to delete in the file, store it
-						// into line_number
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
 
-						cout << endl;
-						cout << "   Line: ";
+					// Deal Workflow Queues
+					else if (toolsChoice == 10)
+					{
+						string advanceDept;
 						FontTextColor.fontTextColor(11);
+						dealershipSystem->displayDealWorkflow();
 
-						cin >> line_number;
+						FontTextColor.fontTextColor(9);
+						cout << "\n   Department to advance (blank to go back): ";
+						FontTextColor.fontTextColor(11);
+						getline(cin, advanceDept);
 
-						if (line_number == 0)
+						if (!advanceDept.empty())
 						{
-							cin.clear();
-							cin.ignore(22, '\n');
-							system("CLS");
-
-							goto CarData;
+							const WorkflowGraph &dealGraph = dealershipSystem->workflow();
+							int deptID = dealGraph.idOf(advanceDept), nextID = -1;
+							if (deptID != -1 && dealGraph.edgesEnd(deptID) - dealGraph.edgesBegin(deptID) > 1)
+							{
+								string nextDept;
+								FontTextColor.fontTextColor(9);
+								cout << "   Hand the deal to (blank = " << dealGraph.nameOf(dealGraph.handoff(deptID)) << "): ";
+								FontTextColor.fontTextColor(11);
+								getline(cin, nextDept);
+								nextID = nextDept.empty() ? -1 : dealGraph.idOf(nextDept);
+								if (!nextDept.empty() && nextID == -1)
+								{
+									deptID = -1; // Unknown department: nothing is advanced
+								}
+							}
+							if (dealershipSystem->advanceDepartment(deptID, currentTimestamp(), nextID))
+							{
+								cout << "\n   " << advanceDept << " moved on to its next deal." << endl;
+							}
+							else
+							{
+								cout << "\n   Nothing to advance in " << advanceDept << "." << endl;
+							}
+							FontTextColor.fontTextColor(9);
+							cout << "\n   ";
+							system("PAUSE");
 						}
+						goto SystemTools;
+					}
 
-						// fstream object will be used to read all of the existing lines in the file
-						fstream read_file;
-
-						// Open the file with the provided filename
-						read_file.open("Text Files/Cars_Color.txt");
+					// Workflow Capacity Simulator
+					else if (toolsChoice == 11)
+					{
+						SimulationConfig simConfig;
+						const WorkflowGraph &simGraph = dealershipSystem->workflow();
+						char replayChoice = 'n';
+						FontTextColor.fontTextColor(9);
+						cout << "   Replay recorded sales and test drives instead of a synthetic year? (y/n): ";
+						FontTextColor.fontTextColor(11);
+						cin >> replayChoice;
 
-						// If file failed to open, exit with an error message and error exit status
-						if (read_file.fail())
+						if (replayChoice == 'y' || replayChoice == 'Y')
 						{
-							system("COLOR 4F");
-							cout << endl;
-							cout << "   Error opening file." << endl;
+							simConfig.replay = dealershipSystem->recordedArrivals();
+						}
+						else
+						{
+							FontTextColor.fontTextColor(9);
+							cout << "   Days to simulate, sale customers per day, test drives per day: ";
+							FontTextColor.fontTextColor(11);
+							cin >> simConfig.days >> simConfig.salesPerDay >> simConfig.testDrivesPerDay;
+						}
 
-							Sleep(3000);
-							goto DeleteCarsColor;
-							// returning 1 instead of 0 is a signal to the shell that something went
-							// wrong in the execution of the program
+						simConfig.staff.assign(simGraph.size(), 1);
+						simConfig.serviceMinutes.assign(simGraph.size(), 30.0);
+						for (int dept = 0; dept < simGraph.size(); dept++)
+						{
+							FontTextColor.fontTextColor(9);
+							cout << "   " << simGraph.nameOf(dept) << " staff and mean service minutes: ";
+							FontTextColor.fontTextColor(11);
+							cin >> simConfig.staff[dept] >> simConfig.serviceMinutes[dept];
 						}
+						cin.ignore();
 
-						// Create a vector to store all the file lines, and a string line to store
-						// each line that we read
-						vector<string> lines;
-						string line;
+						if (cin.fail())
+						{
+							cin.clear();
+							cin.ignore(numeric_limits<streamsize>::max(), '\n');
+							cout << "\n   Wrong input entered!" << endl;
+						}
+						else
+						{
+							dealershipSystem->displaySimulation(simConfig, dealershipSystem->simulateWorkflow(simConfig));
+						}
 
-						// Read each line of the file and store it as the next element of the vector,
-						// the loop will stop when there are no more lines to read
-						while (getline(read_file, line))
-							lines.push_back(line);
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
 
-						// Close our access to the file since we are done reading with it
-						read_file.close();
+					// Recommendation Scoring Benchmark
+					else if (toolsChoice == 12)
+					{
+						int carCount = 1000000;
+						FontTextColor.fontTextColor(9);
+						cout << "   Number of cars (e.g. 1000000): ";
+						FontTextColor.fontTextColor(11);
+						cin >> carCount;
+						cin.ignore();
 
-						// The vector will now contain an element for each line in the file, so the
-						// size of the vector is the number of lines in the file.  Check to make
-						// sure the line number requested does not exceed the number of lines in
-						// the file, if it does, exit with an error message and status.
-						if (line_number > lines.size())
+						if (carCount < 1)
 						{
-							cout << endl;
-							cout << "   Line " << line_number;
-							cout << " not in file." << endl;
+							carCount = 1000000;
+						}
+						benchmarkRecommendationScoring(carCount);
 
-							// Inform user how many lines ARE in the file as part of the error message
-							cout << "   File has " << lines.size();
-							cout << " lines." << endl;
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
 
-							Sleep(3000);
-							goto DeleteCarsColor;
+					// Export Customer Recommendation Lists
+					else if (toolsChoice == 13)
+					{
+						auto exportStart = chrono::steady_clock::now();
+						int exported = dealershipSystem->exportCustomerRecommendations("Text Files/Customer_Recommendations.txt");
+						double exportMs = chrono::duration<double, milli>(chrono::steady_clock::now() - exportStart).count();
+
+						FontTextColor.fontTextColor(11);
+						if (exported < 0)
+						{
+							cout << "   Could not write Text Files/Customer_Recommendations.txt" << endl;
+						}
+						else
+						{
+							cout << "   Top " << RECOMMENDATION_COUNT << " cars for " << exported
+								 << " customers written to Text Files/Customer_Recommendations.txt in "
+								 << exportMs << " ms on " << defaultWorkerThreads() << " threads." << endl;
 						}
 
-						// Create ofstream object for writing to the file
-						ofstream write_file;
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
 
-						// Open the file with the provided filename
-						write_file.open("Text Files/Cars_Color.txt");
+					// Batch Recommendation Scaling Benchmark
+					else if (toolsChoice == 14)
+					{
+						int carCount = 100000, budgetCount = 20000;
+						FontTextColor.fontTextColor(9);
+						cout << "   Number of cars and budgets (e.g. 100000 20000): ";
+						FontTextColor.fontTextColor(11);
+						cin >> carCount >> budgetCount;
+						cin.ignore();
 
-						// If the file failed to open, exit with an error message and exit status
-						if (write_file.fail())
+						if (carCount < 1 || budgetCount < 1)
 						{
-							system("COLOR 4F");
+							carCount = 100000;
+							budgetCount = 20000;
+						}
+						benchmarkBatchRecommendations(carCount, budgetCount);
 
-							cout << endl;
-							cout << "   Error opening file." << endl;
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
 
-							Sleep(3000);
-							goto DeleteCarsColor;
+					// Recommendation Scoring Policy
+					else if (toolsChoice == 15)
+					{
+						int policyChoice = 0;
+						FontTextColor.fontTextColor(11);
+						for (int policy = 0; policy < SCORING_POLICY_COUNT; policy++)
+						{
+							cout << "   " << policy + 1 << ". " << SCORING_POLICIES[policy].name
+								 << (policy == dealershipSystem->currentScoringPolicy() ? "  (current)" : "") << endl;
 						}
+						FontTextColor.fontTextColor(9);
+						cout << "\n   Policy to use: ";
+						FontTextColor.fontTextColor(11);
+						cin >> policyChoice;
+						cin.ignore();
 
-						// Write all of the lines stored in the vector back to the file, EXCEPT the
-						// line that we want to delete.
+						if (dealershipSystem->setScoringPolicy(policyChoice - 1))
+						{
+							cout << "\n   Recommendations now ranked by: " << SCORING_POLICIES[policyChoice - 1].name << endl;
+						}
+						else
+						{
+							cin.clear();
+							cout << "\n   Wrong input entered!" << endl;
+						}
 
-						// Line number 1 will be stored at vector index 0, line number 2 will be
-						// stored at vector index 1, and so on because vectors are zero-indexed, so
-						// decrement line_number to help us identify when we've reached the
-						// associated line in the file.
-						line_number--;
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
 
-						// Loop through the vector elements to write each line back to the file
-						// EXCEPT the line we want to delete.
-						for (int i = 0; i < lines.size(); i++)
-							if (i != line_number)
-								write_file << lines[i] << endl;
+					// Similar Cars
+					else if (toolsChoice == 16)
+					{
+						int likedCarID = 0;
+						FontTextColor.fontTextColor(9);
+						cout << "   Car ID the customer likes: ";
+						FontTextColor.fontTextColor(11);
+						cin >> likedCarID;
+						cin.ignore();
 
-						// Close our access to the file since we are done working with it
-						write_file.close();
+						if (cin.fail())
+						{
+							cin.clear();
+							cin.ignore(numeric_limits<streamsize>::max(), '\n');
+							cout << "\n   Wrong input entered!" << endl;
+						}
+						else
+						{
+							dealershipSystem->displaySimilarCars(likedCarID);
+						}
 
-						cout << endl;
-						cout << "   Line " << line_number + 1 << " has been deleted";
-						cout << endl;
-						cout << "   ";
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
+						system("PAUSE");
+						goto SystemTools;
+					}
+
+					// Workflow Regression Tests
+					else if (toolsChoice == 17)
+					{
+						FontTextColor.fontTextColor(11);
+						int failures = testDealWorkflow();
+						cout << (failures == 0 ? "All checks passed." : "Some checks failed.") << endl;
 
+						FontTextColor.fontTextColor(9);
+						cout << "\n   ";
 						system("PAUSE");
-						goto CarData;
+						goto SystemTools;
 					}
 
 					// Back
-					else if (CarChoice == 9)
+					else if (toolsChoice == 18)
 					{
-						system("CLS");
 						goto AdminMenu;
 					}
 
+					// Wrong input
 					else
 					{
-						// system title
-						system("TITLE Car Dealership Management Program [Error Cars Data]");
-
 						system("CLS");
 						system("COLOR 4F");
 						cout << "\n   Wrong input entered!" << endl;
@@ -4166,59 +9833,12 @@ int main()
 						cout << endl;
 						cout << "   ";
 						system("PAUSE");
-						goto CarData;
+						goto SystemTools;
 					}
 				}
 
-				// Order Logs
-				else if (adminchoice == 3)
-				{
-					// Set system title for order logs
-					system("TITLE Car Dealership Management Program [Order Logs]");
-
-					TitleText.titleText("                           Order Logs                           ");
-
-					OrderLogs.orderLogs();
-
-					FontTextColor.fontTextColor(9);
-					cout << "\n   All Order Logs Data!";
-					cout << endl;
-					cout << "   ";
-					system("PAUSE");
-					goto AdminMenu;
-				}
-
-				// Login Logs
-				else if (adminchoice == 4)
-				{
-					// Set system title for login logs
-					system("TITLE Car Dealership Management Program [Login Logs]");
-
-					TitleText.titleText("                           Login Logs                           ");
-
-					LoginLogs.loginLogs();
-
-					FontTextColor.fontTextColor(9);
-					cout << "\n   All Login Logs Data!";
-					cout << endl;
-					cout << "   ";
-					system("PAUSE");
-					goto AdminMenu;
-				}
-
-				// Order Cars (Admin)
-				else if (adminchoice == 5)
-				{
-					AccessLevel = 1; // Set access level to admin
-
-					// Set system title for admin order cars
-					system("TITLE Car Dealership Management Program [Admin Order Cars]");
-
-					goto OrderCars; // Go to order cars section
-				}
-
 				// About Us (Admin)
-				else if (adminchoice == 6)
+				else if (adminchoice == 7)
 				{
 					// Set system title for about us
 					system("TITLE Car Dealership Management Program [About Us]");
@@ -4231,7 +9851,7 @@ int main()
 				}
 
 				// Logout
-				else if (adminchoice == 7)
+				else if (adminchoice == 8)
 				{
 					system("COLOR A");
 					system("CLS");
@@ -4441,12 +10061,7 @@ int main()
 			{
 
 				// Login Logs [INPUT]
-				auto t = time(nullptr);
-				auto tm = *localtime(&t);
-
-				ostringstream oss;
-				oss << put_time(&tm, "%b/%d/%Y\t%H:%M:%S");
-				auto str = oss.str();
+				const string &str = logTimeFormatter.format(currentTimestamp());
 
 				ofstream Login_Logs("Text Files/Login_Logs.txt", ios::app);
 				Login_Logs << endl
@@ -4485,6 +10100,9 @@ int main()
 
 					OrderLogs.orderLogs();
 
+					FontTextColor.fontTextColor(11);
+					dealershipSystem->displaySalesRollups();
+
 					FontTextColor.fontTextColor(9);
 					cout << "\n   All Order Logs Data!";
 					cout << endl;
@@ -4564,12 +10182,7 @@ int main()
 		else if (choice == 3)
 		{
 			// Record guest login activity in log file
-			auto t = time(nullptr);	  // Get current time
-			auto tm = *localtime(&t); // Convert to local time
-
-			ostringstream oss;							// String stream for formatting
-			oss << put_time(&tm, "%b/%d/%Y\t%H:%M:%S"); // Format date and time
-			auto str = oss.str();						// Convert to string
+			const string &str = logTimeFormatter.format(currentTimestamp()); // Current time as log text
 
 			// Write guest login log entry
 			ofstream Login_Logs("Text Files/Login_Logs.txt", ios::app);
@@ -4641,7 +10254,7 @@ int main()
 
 OrderCars:
 	// Text file to array dynamically XD [Color]
-	string toyota_car_color[15];
+	int toyota_car_color[15]; // Interned color IDs
 	int number_of_color = 0;
 	ifstream Cars_Color("Text Files/Cars_Color.txt");
 	if (Cars_Color.is_open())
@@ -4656,16 +10269,18 @@ OrderCars:
 		if (number_of_color > 15)
 			number_of_color = 15;
 
+		string colorName;
 		for (int i = 0; i < number_of_color; ++i)
 		{
-			Cars_Color >> toyota_car_color[i];
+			Cars_Color >> colorName;
+			toyota_car_color[i] = nameDictionary.intern(colorName);
 		}
 		myCars_Color.close();
 	}
 	Cars_Color.close();
 
 	// Text file to array dynamically XD [Name]
-	string toyota_car_names[17];
+	int toyota_car_names[17]; // Interned model IDs
 	int number_of_name = 0;
 	ifstream Cars_Name("Text Files/Cars_Name.txt");
 	if (Cars_Name.is_open())
@@ -4680,9 +10295,11 @@ OrderCars:
 		if (number_of_name > 17)
 			number_of_name = 17;
 
+		string carName;
 		for (int i = 0; i < number_of_name; ++i)
 		{
-			Cars_Name >> toyota_car_names[i];
+			Cars_Name >> carName;
+			toyota_car_names[i] = nameDictionary.intern(carName);
 		}
 		myCars_Name.close();
 	}
@@ -4774,7 +10391,7 @@ OrderCars:
 		FontTextColor.fontTextColor(9);
 		cout << "\n  You selected ";
 		FontTextColor.fontTextColor(11);
-		cout << toyota_car_names[Cars - 1];
+		cout << nameDictionary.nameOf(toyota_car_names[Cars - 1]);
 		FontTextColor.fontTextColor(9);
 		cout << " for ";
 		FontTextColor.fontTextColor(11);
@@ -4825,7 +10442,7 @@ OrderCars:
 			cout << endl;
 			cout << "   What Color of ";
 			FontTextColor.fontTextColor(11);
-			cout << toyota_car_names[Cars - 1];
+			cout << nameDictionary.nameOf(toyota_car_names[Cars - 1]);
 			FontTextColor.fontTextColor(9);
 			cout << " do you want?";
 			cout << endl;
@@ -4896,11 +10513,11 @@ OrderCars:
 				FontTextColor.fontTextColor(15);
 				cout << "[";
 				FontTextColor.fontTextColor(11);
-				cout << toyota_car_color[Color - 1];
+				cout << nameDictionary.nameOf(toyota_car_color[Color - 1]);
 				FontTextColor.fontTextColor(15);
 				cout << "] ";
 				FontTextColor.fontTextColor(11);
-				cout << toyota_car_names[Cars - 1];
+				cout << nameDictionary.nameOf(toyota_car_names[Cars - 1]);
 				FontTextColor.fontTextColor(9);
 				cout << " for ";
 				FontTextColor.fontTextColor(11);
@@ -4987,31 +10604,22 @@ OrderCars:
 					goto Cashier;
 				}
 
-				// Order Logs [INPUT]
-				auto t = time(nullptr);
-				auto tm = *localtime(&t);
-
-				ostringstream oss;
-				oss << put_time(&tm, "%b/%d/%Y\t%H:%M:%S");
-				auto str = oss.str();
-
-				ofstream Order_Logs("Text Files/Order_Logs.txt", ios::app);
-				Order_Logs << endl
-						   << str << "\t" << toyota_car_names[Cars - 1] << '\t' << toyota_car_color[Color - 1] << '\t' << toyota_car_prices[Cars - 1];
-				Order_Logs.close();
+				// Receipt time; the order log itself is read back from the sales journal
+				const string &str = logTimeFormatter.format(currentTimestamp());
 
-				// Also record in new data structures system
 				// Find or create customer (using a default customer for now)
 				if (dealershipSystem->findCustomer(1) == nullptr)
 				{
 					dealershipSystem->registerCustomer("Default Customer", "000-000-0000", "default@email.com", 100000);
 				}
 
-				// Record the sale in the stack for undo functionality
-				dealershipSystem->recordSale(1, Cars, toyota_car_prices[Cars - 1]);
+				// Journal the sale against an in-stock car of this model, or none
+				// (-1) if the inventory has no such car left
+				dealershipSystem->recordSale(1, dealershipSystem->availableCarOfModel(toyota_car_names[Cars - 1]),
+											 toyota_car_prices[Cars - 1], toyota_car_names[Cars - 1], toyota_car_color[Color - 1]);
 
 			Reciept:
-				Reciept.Reciept(str, toyota_car_names[Cars - 1], toyota_car_color[Color - 1], toyota_car_prices[Cars - 1], Payment, Change);
+				Reciept.Reciept(str, nameDictionary.nameOf(toyota_car_names[Cars - 1]), nameDictionary.nameOf(toyota_car_color[Color - 1]), toyota_car_prices[Cars - 1], Payment, Change);
 
 				// Order again?
 				FontTextColor.fontTextColor(9);